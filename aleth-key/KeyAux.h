@@ -32,6 +32,7 @@
 #include <chrono>
 #include <fstream>
 #include <iosfwd>
+#include <limits>
 #include <thread>
 
 using namespace std;
@@ -124,6 +125,19 @@ public:
 			m_lock = argv[++i];
 		else if (arg == "--kdf" && i + 1 < argc)
 			m_kdf = argv[++i];
+		else if (arg == "--jobs" && i + 1 < argc)
+			try
+			{
+				u256 const jobs(argv[++i]);
+				if (jobs > numeric_limits<unsigned>::max())
+					throw BadArgument();
+				m_jobs = unsigned(jobs);
+			}
+			catch (...)
+			{
+				cerr << "Invalid argument to " << arg << endl;
+				exit(-1);
+			}
 		else if (arg == "--kdf-param" && i + 2 < argc)
 		{
 			auto n = argv[++i];
@@ -439,6 +453,10 @@ public:
 			break;
 		}
 		case OperationMode::ImportBare:
+		{
+			// Raw secrets are encrypted together at the end, running the key derivations in parallel.
+			strings secretInputs;
+			vector<bytesSec> secrets;
 			for (string const& input: m_inputs)
 			{
 				h128 u;
@@ -452,16 +470,58 @@ public:
 						u = secretStore().importKey(input);
 				}
 				if (!u && b.size() == 32)
-					u = secretStore().importSecret(b, lockPassword(toAddress(Secret(b)).abridged()));
+				{
+					secretInputs.push_back(input);
+					secrets.push_back(b);
+					continue;
+				}
 				if (!u)
 				{
 					cerr << "Cannot import " << input << " not a file or secret." << endl;
 					continue;
 				}
-				cout << "Successfully imported " << input << " as " << toUUID(u);
+				cout << "Successfully imported " << input << " as " << toUUID(u) << endl;
+			}
+			if (!secrets.empty())
+			{
+				string const lock = secrets.size() == 1 ? lockPassword(toAddress(Secret(secrets[0])).abridged()) :
+					m_lock.empty() ? createPassword("Enter a passphrase with which to secure the imported keys: ") : m_lock;
+				vector<h128> const uuids = secretStore().importSecrets(secrets, lock, kdf(), m_jobs);
+				for (size_t i = 0; i < uuids.size(); ++i)
+					cout << "Successfully imported " << secretInputs[i] << " as " << toUUID(uuids[i]) << endl;
 			}
 			break;
+		}
 		case OperationMode::InspectBare:
+		{
+			if (m_inputs.size() > 1)
+			{
+				// Several keys: decrypt them all with the same passphrase, in parallel.
+				vector<h128> uuids;
+				strings names;
+				for (auto const& i: m_inputs)
+					if (h128 u = contents(i).empty() ? fromUUID(i) : secretStore().readKey(i, false))
+					{
+						uuids.push_back(u);
+						names.push_back(i);
+					}
+					else
+						cerr << "Couldn't inspect " << i << "; not found." << endl;
+				vector<bytesSec> const secrets = secretStore().secrets(uuids, unlockPassword("Enter passphrase for the keys: "), m_jobs);
+				for (size_t i = 0; i < uuids.size(); ++i)
+				{
+					cout << "Key " << names[i] << ":" << endl;
+					cout << "  UUID: " << toUUID(uuids[i]) << endl;
+					if (secrets[i].empty())
+					{
+						cout << "  Couldn't decrypt; incorrect passphrase." << endl;
+						continue;
+					}
+					cout << "  Address: " << toAddress(Secret(secrets[i])).hex() << endl;
+					cout << "  Secret: " << (m_showSecret ? toHex(secrets[i].ref()) : (toHex(secrets[i].ref().cropped(0, 8)) + "...")) << endl;
+				}
+				break;
+			}
 			for (auto const& i: m_inputs)
 				if (!contents(i).empty())
 				{
@@ -487,8 +547,29 @@ public:
 				else
 					cerr << "Couldn't inspect " << i << "; not found." << endl;
 			break;
+		}
 		case OperationMode::ExportBare: break;
 		case OperationMode::RecodeBare:
+		{
+			if (m_inputs.size() > 1)
+			{
+				// Several keys: recode them all from and to the same passphrases, in parallel.
+				vector<h128> uuids;
+				for (auto const& i: m_inputs)
+					if (h128 u = fromUUID(i))
+						uuids.push_back(u);
+					else
+						cerr << "Couldn't re-encode " << i << "; not found." << endl;
+				string const pass = unlockPassword("Enter current passphrase for the keys: ");
+				vector<bool> const recoded = secretStore().recode(uuids,
+					m_lock.empty() ? createPassword("Enter a new passphrase for the keys: ") : m_lock, pass, kdf(), m_jobs);
+				for (size_t i = 0; i < uuids.size(); ++i)
+					if (recoded[i])
+						cerr << "Re-encoded " << toUUID(uuids[i]) << endl;
+					else
+						cerr << "Couldn't re-encode " << toUUID(uuids[i]) << "; key corrupt or incorrect passphrase supplied." << endl;
+				break;
+			}
 			for (auto const& i: m_inputs)
 				if (h128 u = fromUUID(i))
 					if (secretStore().recode(u, lockPassword(toUUID(u)), [&](){ return getPassword("Enter passphrase for key " + toUUID(u) + ": "); }, kdf()))
@@ -498,6 +579,7 @@ public:
 				else
 					cerr << "Couldn't re-encode " << i << "; not found." << endl;
 			break;
+		}
 		case OperationMode::KillBare:
 			for (auto const& i: m_inputs)
 				if (h128 u = fromUUID(i))
@@ -665,6 +747,12 @@ public:
 		return m_lock.empty() ? createPassword("Enter a passphrase with which to secure account " + _accountName + ": ") : m_lock;
 	}
 
+	/// @returns the first --unlock passphrase, or asks for one.
+	std::string unlockPassword(std::string const& _prompt)
+	{
+		return m_unlocks.empty() ? getPassword(_prompt) : m_unlocks.front();
+	}
+
 	static void streamHelp(ostream& _out)
 	{
 		_out
@@ -674,6 +762,8 @@ public:
 			<< "    importbare [ <file>|<secret-hex> , ... ] Import keys from given sources." << endl
 			<< "    recodebare [ <uuid>|<file> , ... ]  Decrypt and re-encrypt given keys." << endl
 			<< "    inspectbare [ <uuid>|<file> , ... ]  Output information on given keys." << endl
+			<< "    Several keys given to importbare, recodebare or inspectbare share the --lock and --unlock" << endl
+			<< "    passphrases and their key derivations run in parallel." << endl
 //			<< "    exportbare [ <uuid> , ... ]  Export given keys." << endl
 			<< "    killbare [ <uuid> , ... ]  Delete given keys." << endl
 			<< "Secret-store configuration:" << endl
@@ -710,6 +800,7 @@ public:
 			<< "Encryption configuration:" << endl
 			<< "    --kdf <kdfname>  Specify KDF to use when encrypting (default: sc	rypt)" << endl
 			<< "    --kdf-param <name> <value>  Specify a parameter for the KDF." << endl
+			<< "    --jobs <n>  Number of key derivations to run in parallel when handling several bare keys (default: " << SecretStore::defaultKdfThreads() << ")." << endl
 //			<< "    --cipher <ciphername>  Specify cipher to use when encrypting (default: aes-128-ctr)" << endl
 //			<< "    --cipher-param <name> <value>  Specify a parameter for the cipher." << endl
 			<< "    --lock <passphrase>  Specify passphrase for when encrypting a (the) key." << endl
@@ -828,4 +919,6 @@ private:
 
 	string m_kdf = "scrypt";
 	map<string, string> m_kdfParams;
+	/// Key derivations run in parallel, or zero for the default.
+	unsigned m_jobs = 0;
 };
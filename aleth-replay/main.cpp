@@ -0,0 +1,316 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Deterministic block import replay, reporting the import performance broken down by stage.
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/DBFactory.h>
+#include <libdevcore/LoggingProgramOptions.h>
+#include <libdevcore/TransientDirectory.h>
+#include <libethashseal/Ethash.h>
+#include <libethashseal/GenesisInfo.h>
+#include <libethereum/BlockChain.h>
+#include <libethereum/ChainParams.h>
+#include <libethereum/State.h>
+#include <libevm/VMFactory.h>
+
+#include <aleth/buildinfo.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+/// Import stages in the order they happen in BlockChain::import().
+vector<string> const c_stages{"preliminaryChecks", "enactment", "stateCommit", "collation",
+    "writing", "route", "dbWrite", "checkBest"};
+
+void version()
+{
+    auto const* buildinfo = aleth_get_buildinfo();
+    cout << "aleth-replay " << buildinfo->project_version << "\n";
+    cout << "Build: " << buildinfo->system_name << "/" << buildinfo->build_type << "\n";
+    exit(0);
+}
+
+void copyDirectoryRecursive(fs::path const& _from, fs::path const& _to)
+{
+    fs::create_directories(_to);
+    for (fs::recursive_directory_iterator it(_from), end; it != end; ++it)
+    {
+        fs::path const target = _to / fs::relative(it->path(), _from);
+        if (fs::is_directory(it->status()))
+            fs::create_directories(target);
+        else
+            fs::copy_file(it->path(), target, fs::copy_option::overwrite_if_exists);
+    }
+}
+
+struct ReplayStats
+{
+    unsigned blocks = 0;
+    unsigned alreadyKnown = 0;  ///< Blocks of the segment already in the snapshot, not imported.
+    size_t transactions = 0;
+    u256 gasUsed;
+    double seconds = 0;
+    map<string, double> stages;
+};
+
+void printHuman(ReplayStats const& _s)
+{
+    double const total = _s.stages.count("total") ? _s.stages.at("total") : _s.seconds;
+    cout << "Imported " << _s.blocks << " blocks, " << _s.transactions << " transactions, "
+         << _s.gasUsed << " gas in " << _s.seconds << "s\n";
+    if (_s.alreadyKnown)
+        cout << "Skipped " << _s.alreadyKnown << " blocks already known\n";
+    cout << "  blocks/s: " << (_s.seconds > 0 ? _s.blocks / _s.seconds : 0) << "\n";
+    cout << "  gas/s:    " << (_s.seconds > 0 ? _s.gasUsed.convert_to<double>() / _s.seconds : 0)
+         << "\n";
+    for (auto const& name: c_stages)
+    {
+        double const d = _s.stages.count(name) ? _s.stages.at(name) : 0;
+        cout << "  " << name << string(name.size() < 18 ? 18 - name.size() : 1, ' ') << d << "s ("
+             << (total > 0 ? d * 100 / total : 0) << "%)\n";
+    }
+}
+
+void printJson(ReplayStats const& _s)
+{
+    cout << "{\"blocks\": " << _s.blocks << ", \"alreadyKnown\": " << _s.alreadyKnown
+         << ", \"transactions\": " << _s.transactions
+         << ", \"gasUsed\": " << _s.gasUsed << ", \"seconds\": " << _s.seconds
+         << ", \"blocksPerSecond\": " << (_s.seconds > 0 ? _s.blocks / _s.seconds : 0)
+         << ", \"gasPerSecond\": "
+         << (_s.seconds > 0 ? _s.gasUsed.convert_to<double>() / _s.seconds : 0)
+         << ", \"stages\": {";
+    bool first = true;
+    for (auto const& stage: _s.stages)
+    {
+        cout << (first ? "" : ", ") << "\"" << stage.first << "\": " << stage.second;
+        first = false;
+    }
+    cout << "}}\n";
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    setDefaultOrCLocale();
+    string blocksFile;
+    fs::path snapshotPath;
+    string configJSON;
+    fs::path configPath;
+    Network network = Network::MainNetwork;
+    bool checkSeal = false;
+    bool json = false;
+
+    Ethash::init();
+    NoProof::init();
+
+    po::options_description replayOptions("Replay options", c_lineWidth);
+    auto addReplayOption = replayOptions.add_options();
+    addReplayOption("db-snapshot", po::value<string>()->value_name("<path>"),
+        "Data directory holding the chain and the state at the parent of the first replayed "
+        "block, written by the database kind given with --db. It is copied, so that every run "
+        "starts from the same database.");
+    addReplayOption("config", po::value<string>()->value_name("<file>"),
+        "Configure the chain with the given JSON file");
+    addReplayOption("network", po::value<string>()->value_name("<Main|Ropsten>"),
+        "Use the given public network (default: Main)");
+    addReplayOption("check-seal", "Also verify the seal of the blocks");
+    addReplayOption("json", "Output the results as JSON");
+
+    LoggingOptions loggingOptions;
+    po::options_description loggingProgramOptions(
+        createLoggingProgramOptions(c_lineWidth, loggingOptions));
+
+    po::options_description generalOptions("General options", c_lineWidth);
+    auto addGeneralOption = generalOptions.add_options();
+    addGeneralOption("version,v", "Show the version and exit.");
+    addGeneralOption("help,h", "Show this help message and exit.");
+
+    po::options_description allowedOptions(
+        "Usage aleth-replay --db-snapshot <path> <options> <blocks file>");
+    allowedOptions.add(replayOptions)
+        .add(vmProgramOptions(c_lineWidth))
+        .add(db::databaseProgramOptions(c_lineWidth))
+        .add(loggingProgramOptions)
+        .add(generalOptions);
+
+    po::variables_map vm;
+    try
+    {
+        po::parsed_options parsed = po::command_line_parser(argc, argv)
+                                        .options(allowedOptions)
+                                        .allow_unregistered()
+                                        .run();
+        for (auto const& arg: collect_unrecognized(parsed.options, po::include_positional))
+        {
+            if (!blocksFile.empty())
+            {
+                cerr << "Unknown argument: " << arg << "\n";
+                return -1;
+            }
+            blocksFile = arg;
+        }
+        po::store(parsed, vm);
+        po::notify(vm);
+    }
+    catch (po::error const& e)
+    {
+        cerr << e.what() << "\n";
+        return -1;
+    }
+
+    setupLogging(loggingOptions);
+
+    if (vm.count("help"))
+    {
+        cout << allowedOptions;
+        return 0;
+    }
+    if (vm.count("version"))
+        version();
+    if (vm.count("check-seal"))
+        checkSeal = true;
+    if (vm.count("json"))
+        json = true;
+    if (vm.count("network"))
+    {
+        string const name = vm["network"].as<string>();
+        if (name == "Ropsten")
+            network = Network::Ropsten;
+        else if (name != "Main")
+        {
+            cerr << "Unknown network type: " << name << "\n";
+            return -1;
+        }
+    }
+    if (vm.count("config"))
+    {
+        configPath = vm["config"].as<string>();
+        configJSON = contentsString(configPath.string());
+        if (configJSON.empty())
+        {
+            cerr << "Config file not found or empty (" << configPath.string() << ")\n";
+            return -1;
+        }
+    }
+    if (!vm.count("db-snapshot") || blocksFile.empty())
+    {
+        cerr << "Both a database snapshot and a blocks file are required.\n" << allowedOptions;
+        return -1;
+    }
+    snapshotPath = vm["db-snapshot"].as<string>();
+
+    ChainParams chainParams;
+    try
+    {
+        chainParams = configJSON.empty() ?
+                          ChainParams(genesisInfo(network), genesisStateRoot(network)) :
+                          ChainParams().loadConfig(configJSON, {}, configPath);
+    }
+    catch (...)
+    {
+        cerr << "Provided configuration is not well formatted\n";
+        return -1;
+    }
+
+    ifstream blocksIn(blocksFile, ifstream::binary);
+    if (!blocksIn)
+    {
+        cerr << "Can't open " << blocksFile << "\n";
+        return -1;
+    }
+    vector<bytes> blocks;
+    while (blocksIn.peek() != -1)
+    {
+        bytes block(8);
+        blocksIn.read((char*)block.data(), 8);
+        size_t size = 0;
+        if (blocksIn)
+        {
+            try
+            {
+                size = RLP(block, RLP::LaissezFaire).actualSize();
+            }
+            catch (Exception const&)
+            {
+            }
+        }
+        if (size > block.size())
+        {
+            block.resize(size);
+            blocksIn.read((char*)block.data() + 8, block.size() - 8);
+        }
+        if (size <= 8 || !blocksIn)
+        {
+            cerr << "Truncated or malformed block #" << blocks.size() << " in " << blocksFile
+                 << "\n";
+            return -1;
+        }
+        blocks.push_back(move(block));
+    }
+
+    if (!db::isDiskDatabase())
+    {
+        cerr << "The database snapshot can only be replayed on a disk database.\n";
+        return -1;
+    }
+    TransientDirectory dbDir;
+    copyDirectoryRecursive(snapshotPath, dbDir.path());
+
+    BlockChain bc(chainParams, dbDir.path(), WithExisting::Trust);
+    OverlayDB const stateDB = State::openDB(dbDir.path(), bc.genesisHash(), WithExisting::Trust);
+
+    ReplayStats stats;
+    bc.setOnImportPerformance(
+        [&](BlockHeader const&, unordered_map<string, double> const& _stages) {
+            for (auto const& stage: _stages)
+                stats.stages[stage.first] += stage.second;
+        });
+
+    ImportRequirements::value const requirements =
+        checkSeal ? ImportRequirements::OutOfOrderChecks :
+                    ImportRequirements::OutOfOrderChecks & ~ImportRequirements::ValidSeal;
+    Timer timer;
+    for (auto const& block: blocks)
+    {
+        try
+        {
+            VerifiedBlockRef const verified = bc.verifyBlock(&block, {}, requirements);
+            bc.import(verified, stateDB);
+            ++stats.blocks;
+            stats.transactions += verified.transactions.size();
+            stats.gasUsed += verified.info.gasUsed();
+        }
+        catch (AlreadyHaveBlock const&)
+        {
+            ++stats.alreadyKnown;
+        }
+        catch (Exception const& _e)
+        {
+            cerr << "Failed to import block #" << stats.blocks + stats.alreadyKnown
+                 << " of the segment: " << boost::diagnostic_information(_e) << "\n";
+            return -1;
+        }
+    }
+    stats.seconds = timer.elapsed();
+
+    if (json)
+        printJson(stats);
+    else
+        printHuman(stats);
+    return 0;
+}
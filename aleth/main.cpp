@@ -34,6 +34,7 @@
 #include <libdevcore/DBFactory.h>
 #include <libethereum/SnapshotImporter.h>
 #include <libethereum/SnapshotStorage.h>
+#include <libethereum/TransactionPerformance.h>
 #include <libevm/VMFactory.h>
 #include <libwebthree/WebThree.h>
 #include <libethashseal/Ethash.h>
@@ -231,7 +232,15 @@ int main(int argc, char** argv)
         "start-up)");
     addClientOption("kill,K", "Kill the blockchain first");
     addClientOption("rebuild,R", "Rebuild the blockchain from the existing database");
-    addClientOption("rescue", "Attempt to rescue a corrupt database\n");
+    addClientOption("reindex",
+        "Rebuild the blockchain indices from the existing database without re-executing the "
+        "blocks whose state is present");
+    addClientOption("rescue", "Attempt to rescue a corrupt database");
+    addClientOption("tx-performance", po::value<unsigned>()->value_name("<n>"),
+        "Keep performance records of the last <n> imported transactions for "
+        "debug_transactionPerformance");
+    addClientOption("tx-performance-file", po::value<string>()->value_name("<file>"),
+        "Also append the transaction performance records to <file>\n");
     addClientOption("import-presale", po::value<string>()->value_name("<file>"),
         "Import a pre-sale key; you'll need to specify the password to this key");
     addClientOption("import-secret,s", po::value<string>()->value_name("<secret>"),
@@ -469,6 +478,9 @@ int main(int argc, char** argv)
     }
     if (vm.count("unsafe-transactions"))
         alwaysConfirm = false;
+    if (vm.count("tx-performance"))
+        TransactionPerformanceLog::instance().enable(vm["tx-performance"].as<unsigned>(),
+            vm.count("tx-performance-file") ? vm["tx-performance-file"].as<string>() : string());
     if (vm.count("data-dir"))
         setDataDir(vm["data-dir"].as<string>());
     if (vm.count("ipcpath"))
@@ -645,6 +657,8 @@ int main(int argc, char** argv)
         withExisting = WithExisting::Kill;
     if (vm.count("rebuild"))
         withExisting = WithExisting::Verify;
+    if (vm.count("reindex"))
+        withExisting = WithExisting::Reindex;
     if (vm.count("rescue"))
         withExisting = WithExisting::Rescue;
     if (vm.count("address"))
@@ -765,6 +779,7 @@ int main(int argc, char** argv)
     auto netPrefs = publicIP.empty() ? NetworkConfig(listenIP, listenPort, upnp) : NetworkConfig(publicIP, listenIP ,listenPort, upnp);
     netPrefs.discovery = (privateChain.empty() && !disableDiscovery) || enableDiscovery;
     netPrefs.pin = vm.count("pin") != 0;
+    netPrefs.nodeDBPath = getDataDir() / fs::path("nodes.rlp");
 
     auto nodesState = contents(getDataDir() / fs::path("network.rlp"));
 
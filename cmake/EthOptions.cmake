@@ -24,6 +24,7 @@ macro(configure_project)
     # components
     option(TESTS "Build with tests" ON)
     option(TOOLS "Build additional tools" ON)
+    option(BENCHMARKS "Build microbenchmarks (requires TESTS)" OFF)
     # Resolve any clashes between incompatible options.
     if ("${CMAKE_BUILD_TYPE}" STREQUAL "Release")
         if (PARANOID)
@@ -87,6 +88,7 @@ macro(print_config)
     message("------------------------------------------------------------- components")
     message("-- TESTS            Build tests                              ${TESTS}")
     message("-- TOOLS            Build tools                              ${TOOLS}")
+    message("-- BENCHMARKS       Build microbenchmarks                    ${BENCHMARKS}")
     message("------------------------------------------------------------- tests")
     message("-- FASTCTEST        Run only test suites in ctest            ${FASTCTEST}")
     message("-- TESTETH_ARGS     Testeth arguments in ctest:               ")
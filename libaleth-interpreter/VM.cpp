@@ -1277,6 +1277,100 @@ void VM::interpretCases()
         }
         CONTINUE
 
+        CASE(PUSH1ADD)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            // the PUSH1 overflows a full stack
+            if (m_SP == m_stack)
+                throwBadStack(0, 1);
+            updateIOGas();
+
+            m_SPP[0] = m_SP[0] + m_code[m_PC + 1];
+            m_PC += 3;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
+        CASE(PUSH1MSTORE)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            if (m_SP == m_stack)
+                throwBadStack(0, 1);
+            uint64_t const offset = m_code[m_PC + 1];
+            updateMem(offset + 32);
+            updateIOGas();
+
+            *(h256*)&m_mem[offset] = (h256)m_SP[0];
+            m_PC += 3;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
+        CASE(PUSH1JUMPI)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            if (m_SP == m_stack)
+                throwBadStack(0, 1);
+            updateIOGas();
+
+            // destination was verified by optimize()
+            if (m_SP[0])
+                m_PC = m_code[m_PC + 1];
+            else
+                m_PC += 3;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
+        CASE(PUSH2JUMPI)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            if (m_SP == m_stack)
+                throwBadStack(0, 1);
+            updateIOGas();
+
+            // destination was verified by optimize()
+            if (m_SP[0])
+                m_PC = (uint64_t(m_code[m_PC + 1]) << 8) | m_code[m_PC + 2];
+            else
+                m_PC += 4;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
+        CASE(DUPSWAP)
+        {
+#if EVM_FUSE_INSTRUCTIONS
+            ON_OP();
+            unsigned const n = (m_code[m_PC + 1] >> 4) + 1;
+            unsigned const m = (m_code[m_PC + 1] & 0xf) + 1;
+            unsigned const depth = std::max(n, m);
+            if (stackSize() < depth)
+                throwBadStack(depth + 1, 1);
+            updateIOGas();
+
+            // DUPn then SWAPm leaves the m-th item on top and a copy of the n-th in its place
+            new(m_SPP) u256(m_SP[m - 1]);
+            m_SP[m - 1] = m_SP[n - 1];
+            m_PC += 2;
+#else
+            throwBadInstruction();
+#endif
+        }
+        CONTINUE
+
         CASE(DUP1)
         CASE(DUP2)
         CASE(DUP3)
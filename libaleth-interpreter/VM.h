@@ -60,6 +60,21 @@ struct VMSchedule
     static constexpr int64_t callNewAccount = 25000;
 };
 
+/// Code prepared for interpretation: padded, with interpreter-only instructions substituted,
+/// its constants pre-decoded and its jump destinations tabulated. It is immutable once built,
+/// so it is shared by all VMs running the same code.
+struct AnalysedCode
+{
+    /// Padded copy of the code that is interpreted.
+    bytes code;
+
+    /// Constant pool.
+    std::vector<u256> pool;
+
+    /// Sorted positions of JUMPDEST instructions.
+    std::vector<uint64_t> jumpDests;
+};
+
 class VM
 {
 public:
@@ -78,7 +93,8 @@ private:
     static std::array<evmc_instruction_metrics, 256> c_metrics;
     static void initMetrics();
     static u256 exp256(u256 _base, u256 _exponent);
-    void copyCode(int);
+    static std::shared_ptr<AnalysedCode const> analyse(uint8_t const* _code, size_t _codeSize);
+    static int64_t findJumpDest(std::vector<uint64_t> const& _jumpDests, u256 const& _dest);
     typedef void (VM::*MemFnPtr)();
     MemFnPtr m_bounce = nullptr;
     uint64_t m_nSteps = 0;
@@ -91,8 +107,9 @@ private:
 
     uint8_t const* m_pCode = nullptr;
     size_t m_codeSize = 0;
-    // space for code
-    bytes m_code;
+    // analysed code
+    std::shared_ptr<AnalysedCode const> m_analysis;
+    byte const* m_code = nullptr;
 
     /// RETURNDATA buffer for memory returned from direct subcalls.
     bytes m_returnData;
@@ -103,7 +120,7 @@ private:
     size_t stackSize() { return m_stackEnd - m_SP; }
     
     // constant pool
-    std::vector<u256> m_pool;
+    u256 const* m_pool = nullptr;
 
     // interpreter state
     Instruction m_OP;         // current operation
@@ -142,7 +159,6 @@ private:
     void throwBufferOverrun(bigint const& _enfOfAccess);
 
     std::vector<uint64_t> m_beginSubs;
-    std::vector<uint64_t> m_jumpDests;
     int64_t verifyJumpDest(u256 const& _dest, bool _throw = true);
 
     void onOperation() {}
@@ -33,6 +33,8 @@ namespace eth
 //
 // EVM_REPLACE_CONST_JUMP - pre-verified jumps to save runtime lookup
 //
+// EVM_FUSE_INSTRUCTIONS  - common pairs of instructions dispatched as one
+//
 // EVM_TRACE              - provides various levels of tracing
 
 #ifndef EVM_JUMP_DISPATCH
@@ -56,7 +58,9 @@ namespace eth
 #if EVM_OPTIMIZE
 #define EVM_REPLACE_CONST_JUMP true
 #define EVM_USE_CONSTANT_POOL true
-#define EVM_DO_FIRST_PASS_OPTIMIZATION (EVM_REPLACE_CONST_JUMP || EVM_USE_CONSTANT_POOL)
+#define EVM_FUSE_INSTRUCTIONS true
+#define EVM_DO_FIRST_PASS_OPTIMIZATION \
+    (EVM_REPLACE_CONST_JUMP || EVM_USE_CONSTANT_POOL || EVM_FUSE_INSTRUCTIONS)
 #endif
 
 
@@ -317,11 +321,11 @@ namespace eth
         &&LOG2,                                 \
         &&LOG3,                                 \
         &&LOG4,                                 \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
+        &&PUSH1ADD,                             \
+        &&PUSH1MSTORE,                          \
+        &&PUSH1JUMPI,                           \
+        &&PUSH2JUMPI,                           \
+        &&DUPSWAP,                              \
         &&INVALID,                              \
         &&INVALID,                              \
         &&PUSHC,                                \
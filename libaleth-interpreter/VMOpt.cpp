@@ -17,10 +17,111 @@
 
 #include "VM.h"
 
+#include <libdevcore/SHA3.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 namespace dev
 {
 namespace eth
 {
+namespace
+{
+/// Memory taken by the analysed codes kept for reuse by later executions.
+size_t const c_analysisCacheBytes = 64 * 1024 * 1024;
+/// The cache is split by code hash, so that VMs on different threads rarely wait for each other.
+size_t const c_analysisCacheShards = 16;
+
+size_t analysisBytes(AnalysedCode const& _analysis)
+{
+    return sizeof(AnalysedCode) + _analysis.code.size() + _analysis.pool.size() * sizeof(u256) +
+           _analysis.jumpDests.size() * sizeof(uint64_t);
+}
+
+/// Analysed codes by the hash of the code itself, evicting the least recently used ones past its
+/// share of c_analysisCacheBytes.
+class AnalysisCache
+{
+public:
+    std::shared_ptr<AnalysedCode const> find(h256 const& _codeHash)
+    {
+        std::lock_guard<std::mutex> lock(x_entries);
+        auto it = m_entries.find(_codeHash);
+        if (it == m_entries.end())
+            return {};
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        return it->second.analysis;
+    }
+
+    void insert(h256 const& _codeHash, std::shared_ptr<AnalysedCode const> _analysis)
+    {
+        size_t const bytes = analysisBytes(*_analysis);
+        size_t const maxBytes = c_analysisCacheBytes / c_analysisCacheShards;
+        if (bytes > maxBytes)
+            return;
+
+        std::lock_guard<std::mutex> lock(x_entries);
+        // Another VM may have analysed the same code meanwhile.
+        if (m_entries.count(_codeHash))
+            return;
+        m_lru.push_front(_codeHash);
+        m_entries[_codeHash] = Entry{std::move(_analysis), bytes, m_lru.begin()};
+        m_bytes += bytes;
+
+        while (m_bytes > maxBytes)
+        {
+            auto it = m_entries.find(m_lru.back());
+            m_bytes -= it->second.bytes;
+            m_entries.erase(it);
+            m_lru.pop_back();
+        }
+    }
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<AnalysedCode const> analysis;
+        size_t bytes;
+        std::list<h256>::iterator lru;
+    };
+
+    std::mutex x_entries;
+    std::unordered_map<h256, Entry> m_entries;
+    std::list<h256> m_lru;  ///< Most recently used first.
+    size_t m_bytes = 0;
+};
+
+AnalysisCache s_analysisCache[c_analysisCacheShards];
+
+AnalysisCache& analysisCache(h256 const& _codeHash)
+{
+    return s_analysisCache[_codeHash[0] % c_analysisCacheShards];
+}
+
+bool isSynthetic(Instruction _op)
+{
+    return _op == Instruction::PUSHC || _op == Instruction::JUMPC ||
+           _op == Instruction::JUMPCI || _op == Instruction::PUSH1ADD ||
+           _op == Instruction::PUSH1MSTORE || _op == Instruction::PUSH1JUMPI ||
+           _op == Instruction::PUSH2JUMPI || _op == Instruction::DUPSWAP;
+}
+
+/// Metrics of a pair of instructions run as one. Its stack requirement is that of the pair,
+/// checking for a full stack before the first pushes is left to the fused instruction.
+evmc_instruction_metrics fusedMetrics(
+    evmc_instruction_metrics const& _first, evmc_instruction_metrics const& _second)
+{
+    int const args = std::max<int>(
+        _first.num_stack_arguments,
+        _second.num_stack_arguments - _first.num_stack_returned_items + _first.num_stack_arguments);
+    int const returned = args - _first.num_stack_arguments + _first.num_stack_returned_items -
+                         _second.num_stack_arguments + _second.num_stack_returned_items;
+    return {int16_t(_first.gas_cost + _second.gas_cost), int8_t(args), int8_t(returned)};
+}
+}  // namespace
+
 std::array<evmc_instruction_metrics, 256> VM::c_metrics{{}};
 void VM::initMetrics()
 {
@@ -34,50 +135,58 @@ void VM::initMetrics()
         c_metrics[uint8_t(Instruction::PUSHC)] = c_metrics[uint8_t(Instruction::PUSH1)];
         c_metrics[uint8_t(Instruction::JUMPC)] = c_metrics[uint8_t(Instruction::JUMP)];
         c_metrics[uint8_t(Instruction::JUMPCI)] = c_metrics[uint8_t(Instruction::JUMPI)];
+
+        auto const& push = c_metrics[uint8_t(Instruction::PUSH1)];
+        c_metrics[uint8_t(Instruction::PUSH1ADD)] =
+            fusedMetrics(push, c_metrics[uint8_t(Instruction::ADD)]);
+        c_metrics[uint8_t(Instruction::PUSH1MSTORE)] =
+            fusedMetrics(push, c_metrics[uint8_t(Instruction::MSTORE)]);
+        c_metrics[uint8_t(Instruction::PUSH1JUMPI)] =
+            fusedMetrics(push, c_metrics[uint8_t(Instruction::JUMPI)]);
+        c_metrics[uint8_t(Instruction::PUSH2JUMPI)] =
+            c_metrics[uint8_t(Instruction::PUSH1JUMPI)];
+        // the depth of the DUPn and SWAPm operands is checked by DUPSWAP itself
+        c_metrics[uint8_t(Instruction::DUPSWAP)] = {
+            int16_t(c_metrics[uint8_t(Instruction::DUP1)].gas_cost +
+                    c_metrics[uint8_t(Instruction::SWAP1)].gas_cost),
+            0, 1};
         return true;
     }();
     (void)done;
 }
 
-void VM::copyCode(int _extraBytes)
+std::shared_ptr<AnalysedCode const> VM::analyse(uint8_t const* _code, size_t _codeSize)
 {
+    auto analysis = std::make_shared<AnalysedCode>();
+
     // Copy code so that it can be safely modified and extend code by
-    // _extraBytes zero bytes to allow reading virtual data at the end
+    // 33 zero bytes to allow reading virtual data at the end
     // of the code without bounds checks.
-    auto extendedSize = m_codeSize + _extraBytes;
-    m_code.reserve(extendedSize);
-    m_code.assign(m_pCode, m_pCode + m_codeSize);
-    m_code.resize(extendedSize);
-}
-
-void VM::optimize()
-{
-    copyCode(33);
+    bytes& code = analysis->code;
+    code.reserve(_codeSize + 33);
+    code.assign(_code, _code + _codeSize);
+    code.resize(_codeSize + 33);
 
-    size_t const nBytes = m_codeSize;
+    size_t const nBytes = _codeSize;
 
     // build a table of jump destinations for use in verifyJumpDest
     
     TRACE_STR(1, "Build JUMPDEST table")
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
         TRACE_OP(2, pc, op);
                 
         // make synthetic ops in user code trigger invalid instruction if run
-        if (
-            op == Instruction::PUSHC ||
-            op == Instruction::JUMPC ||
-            op == Instruction::JUMPCI
-        )
+        if (isSynthetic(op))
         {
             TRACE_OP(1, pc, op);
-            m_code[pc] = (byte)Instruction::INVALID;
+            code[pc] = (byte)Instruction::INVALID;
         }
 
         if (op == Instruction::JUMPDEST)
         {
-            m_jumpDests.push_back(pc);
+            analysis->jumpDests.push_back(pc);
         }
         else if (
             (byte)Instruction::PUSH1 <= (byte)op &&
@@ -94,18 +203,44 @@ void VM::optimize()
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
         u256 val = 0;
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
 
         if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
             byte nPush = (byte)op - (byte)Instruction::PUSH1 + 1;
 
             // decode pushed bytes to integral value
-            val = m_code[pc+1];
+            val = code[pc+1];
             for (uint64_t i = pc+2, n = nPush; --n; ++i) {
-                val = (val << 8) | m_code[i];
+                val = (val << 8) | code[i];
+            }
+
+        #if EVM_FUSE_INSTRUCTIONS
+
+            // replace PUSH1 or PUSH2 and the instruction consuming the pushed value with a
+            // fused instruction that reads the value in place and skips the consumer
+            size_t const next = pc + nPush + 1;
+            Instruction const nextOp = Instruction(code[next]);
+            Instruction fused = Instruction::INVALID;
+            if (nPush == 1 && nextOp == Instruction::ADD)
+                fused = Instruction::PUSH1ADD;
+            else if (nPush == 1 && nextOp == Instruction::MSTORE)
+                fused = Instruction::PUSH1MSTORE;
+            else if (nPush <= 2 && nextOp == Instruction::JUMPI &&
+                     0 <= findJumpDest(analysis->jumpDests, val))
+                fused = nPush == 1 ? Instruction::PUSH1JUMPI : Instruction::PUSH2JUMPI;
+
+            if (next < nBytes && fused != Instruction::INVALID)
+            {
+                TRACE_PRE_OPT(1, pc, op);
+                code[pc] = byte(op = fused);
+                TRACE_POST_OPT(1, pc, op);
+                pc = next;
+                continue;
             }
 
+        #endif
+
         #if EVM_USE_CONSTANT_POOL
 
             // add value to constant pool and replace PUSHn with PUSHC
@@ -113,16 +248,16 @@ void VM::optimize()
             // followed by one byte count of remaining pushed bytes
             if (5 < nPush)
             {
-                uint16_t pool_off = m_pool.size();
+                uint16_t pool_off = analysis->pool.size();
                 TRACE_VAL(1, "stash", val);
                 TRACE_VAL(1, "... in pool at offset" , pool_off);
-                m_pool.push_back(val);
+                analysis->pool.push_back(val);
 
                 TRACE_PRE_OPT(1, pc, op);
-                m_code[pc] = byte(op = Instruction::PUSHC);
-                m_code[pc+3] = nPush - 2;
-                m_code[pc+2] = pool_off & 0xff;
-                m_code[pc+1] = pool_off >> 8;
+                code[pc] = byte(op = Instruction::PUSHC);
+                code[pc+3] = nPush - 2;
+                code[pc+2] = pool_off & 0xff;
+                code[pc+1] = pool_off >> 8;
                 TRACE_POST_OPT(1, pc, op);
             }
 
@@ -134,14 +269,14 @@ void VM::optimize()
             // outer loop is N = number of bytes in code array
             // so complexity is N log M, worst case is N log N
             size_t i = pc + nPush + 1;
-            op = Instruction(m_code[i]);
+            op = Instruction(code[i]);
             if (op == Instruction::JUMP)
             {
                 TRACE_VAL(1, "Replace const JUMP with JUMPC to", val)
                 TRACE_PRE_OPT(1, i, op);
                 
-                if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPC);
+                if (0 <= findJumpDest(analysis->jumpDests, val))
+                    code[i] = byte(op = Instruction::JUMPC);
                 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -150,8 +285,8 @@ void VM::optimize()
                 TRACE_VAL(1, "Replace const JUMPI with JUMPCI to", val)
                 TRACE_PRE_OPT(1, i, op);
                 
-                if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPCI);
+                if (0 <= findJumpDest(analysis->jumpDests, val))
+                    code[i] = byte(op = Instruction::JUMPCI);
                 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -159,9 +294,51 @@ void VM::optimize()
 
             pc += nPush;
         }
+    #if EVM_FUSE_INSTRUCTIONS
+        else if ((byte)Instruction::DUP1 <= (byte)op && (byte)op <= (byte)Instruction::DUP16)
+        {
+            // replace DUPn SWAPm with DUPSWAP followed by a byte holding n-1 and m-1
+            Instruction const nextOp = Instruction(code[pc + 1]);
+            if (pc + 1 < nBytes && (byte)Instruction::SWAP1 <= (byte)nextOp &&
+                (byte)nextOp <= (byte)Instruction::SWAP16)
+            {
+                TRACE_PRE_OPT(1, pc, op);
+                code[pc + 1] = byte((((byte)op - (byte)Instruction::DUP1) << 4) |
+                                    ((byte)nextOp - (byte)Instruction::SWAP1));
+                code[pc] = byte(op = Instruction::DUPSWAP);
+                TRACE_POST_OPT(1, pc, op);
+                ++pc;
+            }
+        }
+    #endif
     }
     TRACE_STR(1, "Finished optimizations")
 #endif    
+
+    return analysis;
+}
+
+void VM::optimize()
+{
+    // Analyses are cached by the hash of the code being run. The destination's code hash cannot
+    // be used: the host sends DELEGATECALL and CALLCODE as plain calls to the caller's address
+    // while running another account's code. Init code is rarely run twice, so it is not cached.
+    bool const cacheable =
+        m_codeSize && m_message->kind != EVMC_CREATE && m_message->kind != EVMC_CREATE2;
+    h256 const codeHash = cacheable ? sha3(bytesConstRef(m_pCode, m_codeSize)) : h256();
+
+    if (cacheable)
+        m_analysis = analysisCache(codeHash).find(codeHash);
+
+    if (!m_analysis)
+    {
+        m_analysis = analyse(m_pCode, m_codeSize);
+        if (cacheable)
+            analysisCache(codeHash).insert(codeHash, m_analysis);
+    }
+
+    m_code = m_analysis->code.data();
+    m_pool = m_analysis->pool.data();
 }
 
 
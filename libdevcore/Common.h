@@ -296,7 +296,8 @@ enum class WithExisting: int
     Trust = 0,
     Verify,
     Rescue,
-    Kill
+    Kill,
+    Reindex
 };
 
 /// Get the current time in seconds since the epoch in UTC
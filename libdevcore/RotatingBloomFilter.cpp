@@ -0,0 +1,82 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "RotatingBloomFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+
+RotatingBloomFilter::RotatingBloomFilter(size_t _capacity, double _falsePositiveRate)
+  : m_capacity(max<size_t>(_capacity, 1))
+{
+    // Optimal sizing: m = -n ln(p) / ln(2)^2 bits and k = m/n ln(2) bits per hash.
+    double const ln2 = log(2.0);
+    double const bitsPerHash = -log(_falsePositiveRate) / (ln2 * ln2);
+    m_words = max<size_t>(1, static_cast<size_t>(ceil(m_capacity * bitsPerHash / 64)));
+    m_bits = m_words * 64;
+    m_hashes = max(1U, static_cast<unsigned>(round(bitsPerHash * ln2)));
+    m_current.assign(m_words, 0);
+    m_previous.assign(m_words, 0);
+}
+
+void RotatingBloomFilter::bitPositions(h256 const& _hash, uint64_t& o_first, uint64_t& o_step) const
+{
+    // Double hashing (Kirsch-Mitzenmacher) over two words of the hash.
+    memcpy(&o_first, _hash.data(), sizeof(o_first));
+    memcpy(&o_step, _hash.data() + sizeof(o_first), sizeof(o_step));
+    o_step |= 1;
+}
+
+void RotatingBloomFilter::insert(h256 const& _hash)
+{
+    if (test(m_current, _hash))
+        return;
+
+    if (m_currentCount >= m_capacity)
+    {
+        swap(m_previous, m_current);
+        fill(m_current.begin(), m_current.end(), 0);
+        m_currentCount = 0;
+    }
+
+    uint64_t position;
+    uint64_t step;
+    bitPositions(_hash, position, step);
+    for (unsigned i = 0; i < m_hashes; ++i, position += step)
+    {
+        uint64_t const bit = position % m_bits;
+        m_current[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+    ++m_currentCount;
+}
+
+bool RotatingBloomFilter::test(vector<uint64_t> const& _bits, h256 const& _hash) const
+{
+    uint64_t position;
+    uint64_t step;
+    bitPositions(_hash, position, step);
+    for (unsigned i = 0; i < m_hashes; ++i, position += step)
+    {
+        uint64_t const bit = position % m_bits;
+        if (!(_bits[bit / 64] & (uint64_t(1) << (bit % 64))))
+            return false;
+    }
+    return true;
+}
+
+bool RotatingBloomFilter::contains(h256 const& _hash) const
+{
+    return test(m_current, _hash) || test(m_previous, _hash);
+}
+
+void RotatingBloomFilter::clear()
+{
+    fill(m_current.begin(), m_current.end(), 0);
+    fill(m_previous.begin(), m_previous.end(), 0);
+    m_currentCount = 0;
+}
@@ -0,0 +1,55 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Fixed-size probabilistic set of recently seen hashes.
+#pragma once
+
+#include "FixedHash.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace dev
+{
+/**
+ * @brief Remembers roughly the last hashes inserted, in constant memory.
+ *
+ * Two Bloom filters of @a _capacity hashes each are kept: new hashes go to the current one, and
+ * when it is full it replaces the previous one and a fresh filter is started. So at least the
+ * last @a _capacity hashes are always remembered, and at most twice as many.
+ *
+ * The hashes are expected to be uniformly distributed (e.g. Keccak digests), so the filter bits
+ * are derived from the hash bytes directly instead of hashing them again.
+ *
+ * contains() never fails for a hash inserted recently; it may wrongly succeed for other hashes
+ * with a probability of about twice @a _falsePositiveRate.
+ */
+class RotatingBloomFilter
+{
+public:
+    RotatingBloomFilter(size_t _capacity, double _falsePositiveRate);
+
+    void insert(h256 const& _hash);
+    bool contains(h256 const& _hash) const;
+    void clear();
+
+    /// @returns the memory taken by the filter bits, in bytes.
+    size_t memoryUsage() const { return 2 * m_words * sizeof(uint64_t); }
+
+private:
+    void bitPositions(h256 const& _hash, uint64_t& o_first, uint64_t& o_step) const;
+    bool test(std::vector<uint64_t> const& _bits, h256 const& _hash) const;
+
+    size_t m_capacity;
+    size_t m_bits;      ///< Bits in each filter.
+    size_t m_words;     ///< 64-bit words in each filter.
+    unsigned m_hashes;  ///< Bits set for each inserted hash.
+
+    std::vector<uint64_t> m_current;
+    std::vector<uint64_t> m_previous;
+    size_t m_currentCount = 0;  ///< Hashes inserted into m_current.
+};
+
+}  // namespace dev
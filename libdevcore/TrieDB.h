@@ -22,6 +22,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include "Log.h"
 #include "Exceptions.h"
 #include "SHA3.h"
@@ -37,6 +38,10 @@ enum class Verification {
     Normal
 };
 
+/// Trie nodes looked up by hash while building proofs; shared between the proofs of several keys
+/// so that the nodes near the root, common to all of them, are looked up only once.
+using TrieNodeCache = std::unordered_map<h256, std::string>;
+
 /**
  * @brief Merkle Patricia Tree "Trie": a modifed base-16 Radix tree.
  * This version uses a database backend.
@@ -103,6 +108,14 @@ public:
     bool contains(bytes const& _key) const { return contains(&_key); }
     bool contains(bytesConstRef _key) const { return !at(_key).empty(); }
 
+    /// @returns the RLP of the nodes on the path to @a _key, starting with the root: a Merkle
+    /// proof of its value or, if the trie has no such key, of its absence. Nodes embedded in their
+    /// parent are not listed separately. The nodes are taken from, and added to, @a _cache if given.
+    /// The value of @a _key, or an empty string, is put into @a o_value if given.
+    /// @throws InvalidTrie if a node on the path is missing from the database.
+    std::vector<bytes> proof(bytes const& _key, TrieNodeCache* _cache = nullptr, std::string* o_value = nullptr) const { return proof(&_key, _cache, o_value); }
+    std::vector<bytes> proof(bytesConstRef _key, TrieNodeCache* _cache = nullptr, std::string* o_value = nullptr) const;
+
     class iterator
     {
     public:
@@ -327,6 +340,7 @@ public:
 
     bool contains(KeyType _k) const { return Generic::contains(bytesConstRef((byte const*)&_k, sizeof(KeyType))); }
     std::string at(KeyType _k) const { return Generic::at(bytesConstRef((byte const*)&_k, sizeof(KeyType))); }
+    std::vector<bytes> proof(KeyType _k, TrieNodeCache* _cache = nullptr, std::string* o_value = nullptr) const { return Generic::proof(bytesConstRef((byte const*)&_k, sizeof(KeyType)), _cache, o_value); }
     void insert(KeyType _k, bytesConstRef _value) { Generic::insert(bytesConstRef((byte const*)&_k, sizeof(KeyType)), _value); }
     void insert(KeyType _k, bytes const& _value) { insert(_k, bytesConstRef(&_value)); }
     void remove(KeyType _k) { Generic::remove(bytesConstRef((byte const*)&_k, sizeof(KeyType))); }
@@ -389,6 +403,7 @@ public:
 
     std::string at(bytesConstRef _key) const { return Super::at(sha3(_key)); }
     bool contains(bytesConstRef _key) const { return Super::contains(sha3(_key)); }
+    std::vector<bytes> proof(bytesConstRef _key, TrieNodeCache* _cache = nullptr, std::string* o_value = nullptr) const { return Super::proof(sha3(_key), _cache, o_value); }
     void insert(bytesConstRef _key, bytesConstRef _value) { Super::insert(sha3(_key), _value); }
     void remove(bytesConstRef _key) { Super::remove(sha3(_key)); }
 
@@ -440,6 +455,7 @@ public:
 
     std::string at(bytesConstRef _key) const { return Super::at(sha3(_key)); }
     bool contains(bytesConstRef _key) const { return Super::contains(sha3(_key)); }
+    std::vector<bytes> proof(bytesConstRef _key, TrieNodeCache* _cache = nullptr, std::string* o_value = nullptr) const { return Super::proof(sha3(_key), _cache, o_value); }
     void insert(bytesConstRef _key, bytesConstRef _value)
     {
         h256 hash = sha3(_key);
@@ -825,6 +841,67 @@ template <class DB> std::string GenericTrieDB<DB>::atAux(RLP const& _here, Nibbl
     }
 }
 
+template <class DB> std::vector<bytes> GenericTrieDB<DB>::proof(bytesConstRef _key, TrieNodeCache* _cache, std::string* o_value) const
+{
+    std::vector<bytes> ret;
+    std::string value;
+    TrieNodeCache local;
+    TrieNodeCache& cache = _cache ? *_cache : local;
+    // The strings live in the cache, so the RLP views of them stay valid during the walk.
+    auto const lookup = [&](h256 const& _h) -> std::string const& {
+        auto it = cache.find(_h);
+        if (it == cache.end())
+        {
+            std::string n = node(_h);
+            // The empty trie may not be in the database, any other node must be.
+            if (n.empty() && _h == EmptyTrie)
+                n = std::string(1, char(0x80));
+            else if (n.empty())
+                BOOST_THROW_EXCEPTION(InvalidTrie() << errinfo_hash256(_h));
+            it = cache.emplace(_h, std::move(n)).first;
+        }
+        ret.push_back(asBytes(it->second));
+        return it->second;
+    };
+
+    // Same walk as atAux().
+    RLP here(lookup(m_root));
+    NibbleSlice key(_key);
+    while (!here.isEmpty() && !here.isNull())
+    {
+        if (here.itemCount() == 2)
+        {
+            auto k = keyOf(here);
+            if (isLeaf(here))
+            {
+                if (key == k)
+                    value = here[1].toString();
+                break;
+            }
+            if (!key.contains(k))
+                break;
+            key = key.mid(k.size());
+            here = here[1].isList() ? here[1] : RLP(lookup(here[1].toHash<h256>()));
+        }
+        else
+        {
+            if (key.size() == 0)
+            {
+                value = here[16].toString();
+                break;
+            }
+            auto n = here[key[0]];
+            if (n.isEmpty())
+                break;
+            key = key.mid(1);
+            here = n.isList() ? n : RLP(lookup(n.toHash<h256>()));
+        }
+    }
+    if (o_value)
+        *o_value = std::move(value);
+    return ret;
+}
+
 template <class DB> bytes GenericTrieDB<DB>::mergeAt(RLP const& _orig, NibbleSlice _k, bytesConstRef _v, bool _inLine)
 {
     return mergeAt(_orig, sha3(_orig.data()), _k, _v, _inLine);
@@ -20,6 +20,8 @@
  */
 
 #include "SecretStore.h"
+#include <atomic>
+#include <exception>
 #include <thread>
 #include <mutex>
 #include <boost/algorithm/string.hpp>
@@ -151,7 +153,7 @@ h128 SecretStore::importSecret(bytesSec const& _s, string const& _pass)
 	EncryptedKey key{encrypt(_s.ref(), _pass), toUUID(r), KeyPair(Secret(_s)).address()};
 	m_cached[r] = _s;
 	m_keys[r] = move(key);
-	save();
+	saveKey(r);
 	return r;
 }
 
@@ -161,7 +163,7 @@ h128 SecretStore::importSecret(bytesConstRef _s, string const& _pass)
 	EncryptedKey key{encrypt(_s, _pass), toUUID(r), KeyPair(Secret(_s)).address()};
 	m_cached[r] = bytesSec(_s);
 	m_keys[r] = move(key);
-	save();
+	saveKey(r);
 	return r;
 }
 
@@ -185,21 +187,34 @@ void SecretStore::save(fs::path const& _keysPath)
 	fs::create_directories(_keysPath);
 	DEV_IGNORE_EXCEPTIONS(fs::permissions(_keysPath, fs::owner_all));
 	for (auto& k: m_keys)
-	{
-		string uuid = toUUID(k.first);
-		fs::path filename = (_keysPath / uuid).string() + ".json";
-		js::mObject v;
-		js::mValue crypto;
-		js::read_string(k.second.encryptedKey, crypto);
-		v["address"] = k.second.address.hex();
-		v["crypto"] = crypto;
-		v["id"] = uuid;
-		v["version"] = c_keyFileVersion;
-		writeFile(filename, js::write_string(js::mValue(v), true));
-		swap(k.second.filename, filename);
-		if (!filename.empty() && !fs::equivalent(filename, k.second.filename))
-			fs::remove(filename);
-	}
+		saveKey(_keysPath, k);
+}
+
+void SecretStore::saveKey(h128 const& _uuid)
+{
+	// Only the changed key is written, so that importing or recoding many keys stays linear.
+	fs::create_directories(m_path);
+	DEV_IGNORE_EXCEPTIONS(fs::permissions(m_path, fs::owner_all));
+	auto it = m_keys.find(_uuid);
+	if (it != m_keys.end())
+		saveKey(m_path, *it);
+}
+
+void SecretStore::saveKey(fs::path const& _keysPath, pair<h128 const, EncryptedKey>& _key)
+{
+	string uuid = toUUID(_key.first);
+	fs::path filename = (_keysPath / uuid).string() + ".json";
+	js::mObject v;
+	js::mValue crypto;
+	js::read_string(_key.second.encryptedKey, crypto);
+	v["address"] = _key.second.address.hex();
+	v["crypto"] = crypto;
+	v["id"] = uuid;
+	v["version"] = c_keyFileVersion;
+	writeFile(filename, js::write_string(js::mValue(v), true));
+	swap(_key.second.filename, filename);
+	if (!filename.empty() && !fs::equivalent(filename, _key.second.filename))
+		fs::remove(filename);
 }
 
 bool SecretStore::noteAddress(h128 const& _uuid, Address const& _address)
@@ -267,7 +282,7 @@ bool SecretStore::recode(Address const& _address, string const& _newPass, functi
 		else
 		{
 			k->second.encryptedKey = encrypt(s.ref(), _newPass, _kdf);
-			save();
+			saveKey(k->first);
 			return true;
 		}
 	}
@@ -297,10 +312,131 @@ bool SecretStore::recode(h128 const& _uuid, string const& _newPass, function<str
 		return false;
 	m_cached.erase(_uuid);
 	m_keys[_uuid].encryptedKey = encrypt(s.ref(), _newPass, _kdf);
-	save();
+	saveKey(_uuid);
 	return true;
 }
 
+namespace
+{
+/// Memory of a default scrypt derivation (128 * r * n bytes).
+size_t const c_scryptMemory = 128 * 8 * (size_t(1) << 18);
+/// Memory that the key derivations run in parallel may take together.
+size_t const c_kdfMemoryBudget = size_t(2) << 30;
+
+/// Calls @a _f for each index below @a _count on @a _threads threads. Rethrows the first exception.
+void parallelFor(size_t _count, unsigned _threads, function<void(size_t)> const& _f)
+{
+	atomic<size_t> next{0};
+	mutex x_error;
+	exception_ptr error;
+	auto work = [&]() {
+		for (size_t i = next++; i < _count; i = next++)
+			try
+			{
+				_f(i);
+			}
+			catch (...)
+			{
+				lock_guard<mutex> l(x_error);
+				if (!error)
+					error = current_exception();
+			}
+	};
+
+	vector<thread> threads;
+	for (unsigned i = 1; i < _threads && i < _count; ++i)
+		threads.emplace_back(work);
+	work();
+	for (auto& t: threads)
+		t.join();
+	if (error)
+		rethrow_exception(error);
+}
+}
+
+unsigned SecretStore::defaultKdfThreads()
+{
+	unsigned const cores = max(1u, thread::hardware_concurrency());
+	return max<unsigned>(1, min<size_t>(cores, c_kdfMemoryBudget / c_scryptMemory));
+}
+
+vector<h128> SecretStore::importSecrets(vector<bytesSec> const& _secrets, string const& _pass, KDF _kdf, unsigned _threads)
+{
+	vector<string> encrypted(_secrets.size());
+	parallelFor(_secrets.size(), _threads ? _threads : defaultKdfThreads(), [&](size_t i) {
+		encrypted[i] = encrypt(_secrets[i].ref(), _pass, _kdf);
+	});
+
+	vector<h128> ret;
+	for (size_t i = 0; i < _secrets.size(); ++i)
+	{
+		h128 r = h128::random();
+		m_keys[r] = EncryptedKey{move(encrypted[i]), toUUID(r), KeyPair(Secret(_secrets[i])).address()};
+		m_cached[r] = _secrets[i];
+		saveKey(r);
+		ret.push_back(r);
+	}
+	return ret;
+}
+
+vector<bool> SecretStore::recode(vector<h128> const& _uuids, string const& _newPass, string const& _pass, KDF _kdf, unsigned _threads)
+{
+	vector<string> current;
+	for (auto const& u: _uuids)
+	{
+		auto it = m_keys.find(u);
+		current.push_back(it != m_keys.end() ? it->second.encryptedKey : string());
+	}
+
+	vector<string> recoded(_uuids.size());
+	parallelFor(_uuids.size(), _threads ? _threads : defaultKdfThreads(), [&](size_t i) {
+		if (current[i].empty())
+			return;
+		bytesSec const s = decrypt(current[i], _pass);
+		if (!s.empty())
+			recoded[i] = encrypt(s.ref(), _newPass, _kdf);
+	});
+
+	vector<bool> ret;
+	for (size_t i = 0; i < _uuids.size(); ++i)
+	{
+		ret.push_back(!recoded[i].empty());
+		if (recoded[i].empty())
+			continue;
+		m_cached.erase(_uuids[i]);
+		m_keys[_uuids[i]].encryptedKey = move(recoded[i]);
+		saveKey(_uuids[i]);
+	}
+	return ret;
+}
+
+vector<bytesSec> SecretStore::secrets(vector<h128> const& _uuids, string const& _pass, unsigned _threads)
+{
+	vector<bytesSec> ret(_uuids.size());
+	vector<string> encrypted;
+	for (size_t i = 0; i < _uuids.size(); ++i)
+	{
+		auto cached = m_cached.find(_uuids[i]);
+		if (cached != m_cached.end())
+			ret[i] = cached->second;
+		auto it = m_keys.find(_uuids[i]);
+		encrypted.push_back(ret[i].empty() && it != m_keys.end() ? it->second.encryptedKey : string());
+	}
+
+	parallelFor(_uuids.size(), _threads ? _threads : defaultKdfThreads(), [&](size_t i) {
+		if (!encrypted[i].empty())
+			ret[i] = decrypt(encrypted[i], _pass);
+	});
+
+	for (size_t i = 0; i < _uuids.size(); ++i)
+		if (!encrypted[i].empty() && !ret[i].empty())
+		{
+			m_cached[_uuids[i]] = ret[i];
+			noteAddress(_uuids[i], toAddress(Secret{ret[i]}));
+		}
+	return ret;
+}
+
 static bytesSec deriveNewKey(string const& _pass, KDF _kdf, js::mObject& o_ret)
 {
 	unsigned dklen = 32;
@@ -76,10 +76,10 @@ public:
 	/// @param _pass function that returns the password for the key.
 	bytesSec secret(Address const& _address, std::function<std::string()> const& _pass) const;
 	/// Imports the (encrypted) key stored in the file @a _file and copies it to the managed directory.
-	h128 importKey(std::string const& _file) { auto ret = readKey(_file, false); if (ret) save(); return ret; }
+	h128 importKey(std::string const& _file) { auto ret = readKey(_file, false); if (ret) saveKey(ret); return ret; }
 	/// Imports the (encrypted) key contained in the json formatted @a _content and stores it in
 	/// the managed directory.
-	h128 importKeyContent(std::string const& _content) { auto ret = readKeyContent(_content, std::string()); if (ret) save(); return ret; }
+	h128 importKeyContent(std::string const& _content) { auto ret = readKeyContent(_content, std::string()); if (ret) saveKey(ret); return ret; }
 	/// Imports the decrypted key given by @a _s and stores it, encrypted with
 	/// (a key derived from) the password @a _pass.
 	h128 importSecret(bytesSec const& _s, std::string const& _pass);
@@ -88,6 +88,21 @@ public:
 	bool recode(h128 const& _uuid, std::string const& _newPass, std::function<std::string()> const& _pass, KDF _kdf = KDF::Scrypt);
 	/// Decrypts and re-encrypts the key identified by @a _address.
 	bool recode(Address const& _address, std::string const& _newPass, std::function<std::string()> const& _pass, KDF _kdf = KDF::Scrypt);
+	/// Imports the decrypted keys @a _secrets, all encrypted with (keys derived from) the password
+	/// @a _pass. The key derivations run on @a _threads threads, or defaultKdfThreads() if zero.
+	/// @returns the uuids of the keys, in the same order.
+	std::vector<h128> importSecrets(std::vector<bytesSec> const& _secrets, std::string const& _pass, KDF _kdf = KDF::Scrypt, unsigned _threads = 0);
+	/// Decrypts the keys @a _uuids with @a _pass and re-encrypts them with @a _newPass, running the
+	/// key derivations on @a _threads threads, or defaultKdfThreads() if zero.
+	/// @returns whether each key could be decrypted and was re-encoded.
+	std::vector<bool> recode(std::vector<h128> const& _uuids, std::string const& _newPass, std::string const& _pass, KDF _kdf = KDF::Scrypt, unsigned _threads = 0);
+	/// Decrypts the keys @a _uuids with @a _pass, running the key derivations on @a _threads
+	/// threads, or defaultKdfThreads() if zero. @returns the secrets, empty for the keys which
+	/// can't be decrypted. Caches the secrets and notes the addresses of the keys decrypted.
+	std::vector<bytesSec> secrets(std::vector<h128> const& _uuids, std::string const& _pass, unsigned _threads = 0);
+	/// @returns the number of key derivations to run in parallel by default: one per core, as
+	/// long as their scrypt memory stays within a fixed budget.
+	static unsigned defaultKdfThreads();
 	/// Removes the key specified by @a _uuid from both memory and disk.
 	void kill(h128 const& _uuid);
 
@@ -124,7 +139,12 @@ public:
 	static boost::filesystem::path defaultPath() { return getDataDir("web3") / boost::filesystem::path("keys"); }
 
 private:
-	/// Loads all keys in the given directory.
+	/// Stores the key @a _uuid in the managed directory.
+	void saveKey(h128 const& _uuid);
+	/// Stores the key @a _key in the directory @a _keysPath.
+	void saveKey(boost::filesystem::path const& _keysPath, std::pair<h128 const, EncryptedKey>& _key);
+	/// Loads all keys in the given directory. This reads and parses every key file but runs no key
+	/// derivation; loading them lazily would not save the file reads, so it is not done.
 	void load(boost::filesystem::path const& _keysPath);
 	void load() { load(m_path); }
 	/// Encrypts @a _v with a key derived from @a _pass or the empty string on error.
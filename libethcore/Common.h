@@ -123,7 +123,9 @@ enum class ImportResult
 	Malformed,
 	OverbidGasPrice,
 	BadChain,
-	ZeroSignature
+	ZeroSignature,
+	TooManyFromSender,
+	QueueFull  ///< Accepted, then evicted at once as the worst transaction of the full queue.
 };
 
 struct ImportRequirements
@@ -25,6 +25,7 @@
 #include <mutex>
 #include <libdevcore/FileSystem.h>
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Guards.h>
 #include <libdevcrypto/SecretStore.h>
 
 #include <boost/filesystem.hpp>
@@ -110,6 +111,10 @@ public:
 	h128 import(Secret const& _s, std::string const& _accountName) { return import(_s, _accountName, defaultPassword(), std::string()); }
 
 	SecretStore& store() { return m_store; }
+
+	/// The key manager is not thread-safe: code sharing it between threads, such as the RPC
+	/// handlers, holds this mutex around every call. Its methods don't take it themselves.
+	Mutex& mutex() const { return x_keyManager; }
 	void importExisting(h128 const& _uuid, std::string const& _accountName, std::string const& _pass, std::string const& _passwordHint);
 	void importExisting(h128 const& _uuid, std::string const& _accountName, Address const& _addr, h256 const& _passHash = h256(), std::string const& _passwordHint = std::string());
 
@@ -173,6 +178,8 @@ private:
 	mutable SecureFixedHash<16> m_keysFileKey;
 	mutable h256 m_master;
 	SecretStore m_store;
+
+	mutable Mutex x_keyManager;
 };
 
 }
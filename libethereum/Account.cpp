@@ -41,6 +41,16 @@ void Account::setCode(bytes&& _code)
     m_codeHash = sha3(m_codeCache);
 }
 
+void Account::noteCommitted(h256 const& _storageRoot)
+{
+    for (auto const& i: m_storageOverlay)
+        m_storageOriginal[i.first] = i.second;
+    m_storageOverlay.clear();
+    m_storageRoot = _storageRoot;
+    m_hasNewCode = false;
+    m_isUnchanged = true;
+}
+
 u256 Account::originalStorageValue(u256 const& _key, OverlayDB const& _db) const
 {
     auto it = m_storageOriginal.find(_key);
@@ -101,6 +101,10 @@ public:
 
     void untouch() { m_isUnchanged = true; }
 
+    /// Mark the account as matching the state trie after its changes were committed there,
+    /// with @a _storageRoot as the new root of its storage.
+    void noteCommitted(h256 const& _storageRoot);
+
     /// @returns true if the nonce, balance and code is zero / empty. Code is considered empty
     /// during creation phase.
     bool isEmpty() const { return nonce() == 0 && balance() == 0 && codeHash() == EmptySHA3; }
@@ -140,6 +144,10 @@ public:
     /// not taking into account overlayed modifications
     u256 originalStorageValue(u256 const& _key, OverlayDB const& _db) const;
 
+    /// @returns the number of original storage values cached, which grows with every value read
+    /// from the DB.
+    size_t originalStorageCacheSize() const { return m_storageOriginal.size(); }
+
     /// @returns the storage overlay as a simple hash map.
     std::unordered_map<u256, u256> const& storageOverlay() const { return m_storageOverlay; }
 
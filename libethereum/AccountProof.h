@@ -0,0 +1,39 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Merkle proof of an account, as returned by eth_getProof.
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/SHA3.h>
+#include <libdevcore/TrieCommon.h>
+
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+/// Merkle proof of an account and of some of its storage slots, as returned by eth_getProof.
+/// The values are the committed ones, which the proofs are checked against.
+struct AccountProof
+{
+    struct StorageProof
+    {
+        u256 key;
+        u256 value;
+        std::vector<bytes> proof;  ///< Storage trie nodes on the path to the slot.
+    };
+
+    u256 nonce;
+    u256 balance;
+    h256 storageRoot = EmptyTrie;
+    h256 codeHash = EmptySHA3;
+    std::vector<bytes> proof;  ///< State trie nodes on the path to the account.
+    std::vector<StorageProof> storage;
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -21,6 +21,7 @@
 
 #include "Block.h"
 
+#include <chrono>
 #include <ctime>
 #include <boost/filesystem.hpp>
 #include <boost/timer.hpp>
@@ -33,6 +34,7 @@
 #include "BlockChain.h"
 #include "ExtVM.h"
 #include "Executive.h"
+#include "TransactionPerformance.h"
 #include "TransactionQueue.h"
 #include "GenesisInfo.h"
 using namespace std;
@@ -251,7 +253,7 @@ bool Block::sync(BlockChain const& _bc, h256 const& _block, BlockHeader const& _
         // Find most recent state dump and replay what's left.
         // (Most recent state dump might end up being genesis.)
 
-        if (m_state.db().lookup(bi.stateRoot()).empty())	// TODO: API in State for this?
+        if (m_state.db().lookup(bi.stateRoot()).empty() && !syncStateWithDiffs(_bc, bi))	// TODO: API in State for this?
         {
             cwarn << "Unable to sync to" << bi.hash() << "; state root" << bi.stateRoot() << "not found in database.";
             cwarn << "Database corrupt: contains block without stateRoot:" << bi;
@@ -304,6 +306,31 @@ bool Block::sync(BlockChain const& _bc, h256 const& _block, BlockHeader const& _
     return ret;
 }
 
+bool Block::syncStateWithDiffs(BlockChain const& _bc, BlockHeader const& _bi)
+{
+    if (!_bc.stateDiffHistory())
+        return false;
+
+    for (BlockHeader const& base : {m_previousBlock, _bc.info()})
+    {
+        if (!base || m_state.db().lookup(base.stateRoot()).empty())
+            continue;
+        try
+        {
+            m_state.setRoot(base.stateRoot());
+            if (_bc.applyStateDiffs(m_state, base.hash(), _bi.hash()) &&
+                m_state.rootHash() == _bi.stateRoot())
+                return true;
+        }
+        catch (InvalidStateDiffRoot const&)
+        {
+            cwarn << "State diffs between" << base.hash() << "and" << _bi.hash()
+                  << "don't match the state.";
+        }
+    }
+    return false;
+}
+
 pair<TransactionReceipts, bool> Block::sync(BlockChain const& _bc, TransactionQueue& _tq, GasPricer const& _gp, unsigned msTimeout)
 {
     if (isSealed())
@@ -320,6 +347,7 @@ pair<TransactionReceipts, bool> Block::sync(BlockChain const& _bc, TransactionQu
 
     assert(_bc.currentHash() == m_currentBlock.parentHash());
     auto deadline =  chrono::steady_clock::now() + chrono::milliseconds(msTimeout);
+    EnvInfo envInfo(info(), _bc.lastBlockHashes(), 0);
 
     for (int goodTxs = max(0, (int)transactions.size() - 1); goodTxs < (int)transactions.size();)
     {
@@ -332,7 +360,7 @@ pair<TransactionReceipts, bool> Block::sync(BlockChain const& _bc, TransactionQu
                     if (t.gasPrice() >= _gp.ask(*this))
                     {
 //						Timer t;
-                        execute(_bc.lastBlockHashes(), t);
+                        execute(envInfo, t);
                         ret.first.push_back(m_receipts.back());
                         ++goodTxs;
 //						cnote << "TX took:" << t.elapsed() * 1000;
@@ -487,14 +515,22 @@ u256 Block::enact(VerifiedBlockRef const& _block, BlockChain const& _bc)
     vector<bytes> receipts;
 
     // All ok with the block generally. Play back the transactions now...
+    // They share one environment, so that the block hashes window is looked up once per block.
+    EnvInfo envInfo(info(), _bc.lastBlockHashes(), 0);
+    TransactionPerformanceLog& performanceLog = TransactionPerformanceLog::instance();
     unsigned i = 0;
     DEV_TIMED_ABOVE("txExec", 500)
         for (Transaction const& tr: _block.transactions)
         {
+            bool const recordPerformance = performanceLog.enabled();
+            if (recordPerformance)
+                m_state.resetExecutionCounters();
+            u256 const gasBefore = gasUsed();
+            auto const start = chrono::steady_clock::now();
             try
             {
 //				cnote << "Enacting transaction: " << tr.nonce() << tr.from() << state().transactionsFrom(tr.from()) << tr.value();
-                execute(_bc.lastBlockHashes(), tr);
+                execute(envInfo, tr);
 //				cnote << "Now: " << tr.from() << state().transactionsFrom(tr.from());
 //				cnote << m_state;
             }
@@ -504,6 +540,22 @@ u256 Block::enact(VerifiedBlockRef const& _block, BlockChain const& _bc)
                 throw;
             }
 
+            if (recordPerformance)
+            {
+                TransactionPerformance record;
+                record.microseconds = chrono::duration_cast<chrono::microseconds>(
+                    chrono::steady_clock::now() - start).count();
+                record.transaction = tr.sha3();
+                record.blockNumber = static_cast<unsigned>(m_currentBlock.number());
+                record.index = i;
+                if (!tr.isCreation())
+                    record.to = tr.receiveAddress();
+                record.gasUsed = gasUsed() - gasBefore;
+                record.counters = m_state.executionCounters();
+                record.vm = VMFactory::kindName();
+                performanceLog.record(move(record));
+            }
+
             RLPStream receiptRLP;
             m_receipts.back().streamRLP(receiptRLP);
             receipts.push_back(receiptRLP.out());
@@ -655,6 +707,12 @@ u256 Block::enact(VerifiedBlockRef const& _block, BlockChain const& _bc)
 }
 
 ExecutionResult Block::execute(LastBlockHashesFace const& _lh, Transaction const& _t, Permanence _p, OnOpFunc const& _onOp)
+{
+    EnvInfo envInfo(info(), _lh, 0);
+    return execute(envInfo, _t, _p, _onOp);
+}
+
+ExecutionResult Block::execute(EnvInfo& _envInfo, Transaction const& _t, Permanence _p, OnOpFunc const& _onOp)
 {
     if (isSealed())
         BOOST_THROW_EXCEPTION(InvalidOperationOnSealedBlock());
@@ -663,7 +721,8 @@ ExecutionResult Block::execute(LastBlockHashesFace const& _lh, Transaction const
     // transaction as possible.
     uncommitToSeal();
 
-    std::pair<ExecutionResult, TransactionReceipt> resultReceipt = m_state.execute(EnvInfo(info(), _lh, gasUsed()), *m_sealEngine, _t, _p, _onOp);
+    _envInfo.setGasUsed(gasUsed());
+    std::pair<ExecutionResult, TransactionReceipt> resultReceipt = m_state.execute(_envInfo, *m_sealEngine, _t, _p, _onOp);
 
     if (_p == Permanence::Committed)
     {
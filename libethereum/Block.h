@@ -148,6 +148,9 @@ public:
     /// @returns bytes() if no account exists at that address.
     bytes const& code(Address const& _contract) const { return m_state.code(_contract); }
 
+    /// Get the Merkle proof of an account and of some of its storage slots.
+    AccountProof proof(Address const& _address, u256s const& _keys) const { return m_state.proof(_address, _keys); }
+
     /// Get the code hash of an account.
     /// @returns EmptySHA3 if no account exists at that address or if there is no code associated with the address.
     h256 codeHash(Address const& _contract) const { return m_state.codeHash(_contract); }
@@ -275,9 +278,19 @@ public:
 private:
     SealEngineFace* sealEngine() const;
 
+    /// Bring the state to the block @a _bi using the state diffs recorded by @a _bc, when the state
+    /// root of @a _bi is not in the database. Starts from m_previousBlock, as on a rewind, and
+    /// otherwise from the head of @a _bc, as on the import of a fork block.
+    /// @returns true if the state now has the state root of @a _bi.
+    bool syncStateWithDiffs(BlockChain const& _bc, BlockHeader const& _bi);
+
     /// Undo the changes to the state for committing to mine.
     void uncommitToSeal();
 
+    /// Execute a given transaction in the given environment, which may be shared by the
+    /// transactions of the block; its gas used is updated before the execution.
+    ExecutionResult execute(EnvInfo& _envInfo, Transaction const& _t, Permanence _p = Permanence::Committed, OnOpFunc const& _onOp = OnOpFunc());
+
     /// Execute the given block, assuming it corresponds to m_currentBlock.
     /// Throws on failure.
     u256 enact(VerifiedBlockRef const& _block, BlockChain const& _bc);
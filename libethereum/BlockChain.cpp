@@ -38,6 +38,10 @@
 #include <boost/exception/errinfo_nested_exception.hpp>
 #include <boost/filesystem.hpp>
 
+#include <array>
+#include <atomic>
+#include <thread>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
@@ -49,6 +53,9 @@ namespace
 {
 std::string const c_chainStart{"chainStart"};
 db::Slice const c_sliceChainStart{c_chainStart};
+
+/// Number of blocks re-executed between two progress reports.
+unsigned const c_reexecuteLogInterval = 1000;
 }
 
 std::ostream& dev::eth::operator<<(std::ostream& _out, BlockChain const& _bc)
@@ -112,6 +119,10 @@ db::Slice dev::eth::toSlice(uint64_t _n, unsigned _sub)
 namespace
 {
 
+/// Hashes of the 256 blocks preceding and including the most recently queried one, kept in a
+/// ring buffer. A query for another block walks back from it only until it meets the buffer,
+/// replacing the divergent suffix and refilling the oldest entries, so importing a block on top
+/// of the previous one costs a single details lookup and a reorganisation costs its depth.
 class LastBlockHashes: public LastBlockHashesFace
 {
 public:
@@ -119,28 +130,98 @@ public:
 
     h256s precedingHashes(h256 const& _mostRecentHash) const override
     {
+        h256s ret(c_size);
         Guard l(m_lastHashesMutex);
-        if (m_lastHashes.empty() || m_lastHashes.front() != _mostRecentHash)
+        if (!update(_mostRecentHash))
         {
-            m_lastHashes.resize(256);
-            m_lastHashes[0] = _mostRecentHash;
-            for (unsigned i = 0; i < 255; ++i)
-                m_lastHashes[i + 1] = m_lastHashes[i] ? m_bc.info(m_lastHashes[i]).parentHash() : h256();
+            // Not a block of the chain, so there is nothing known to precede it.
+            ret[0] = _mostRecentHash;
+            return ret;
         }
-        return m_lastHashes;
+        for (unsigned i = 0; i < m_count; ++i)
+            ret[i] = m_ring[(m_newest + c_size - i) % c_size];
+        return ret;
     }
 
     void clear() override
     {
         Guard l(m_lastHashesMutex);
-        m_lastHashes.clear();
+        m_count = 0;
     }
 
 private:
+    static unsigned const c_size = 256;
+
+    /// @returns true if the buffer holds @a _hash as the block number @a _number.
+    bool contains(unsigned _number, h256 const& _hash) const
+    {
+        return m_count && _number <= m_newestNumber && m_newestNumber - _number < m_count &&
+               m_ring[(m_newest + c_size - (m_newestNumber - _number)) % c_size] == _hash;
+    }
+
+    /// Makes @a _mostRecentHash the newest entry of the buffer.
+    /// @returns false if it is not a known block.
+    bool update(h256 const& _mostRecentHash) const
+    {
+        if (m_count && m_ring[m_newest] == _mostRecentHash)
+            return true;
+
+        BlockDetails details = m_bc.details(_mostRecentHash);
+        if (!details)
+            return false;
+        unsigned const mostRecentNumber = details.number;
+
+        // Collect the blocks missing from the buffer, newest first.
+        h256s suffix;
+        h256 hash = _mostRecentHash;
+        unsigned number = mostRecentNumber;
+        while (!contains(number, hash))
+        {
+            if (!suffix.empty())
+                details = m_bc.details(hash);
+            suffix.push_back(hash);
+            if (number == 0 || suffix.size() == c_size)
+                break;
+            hash = details.parent;
+            --number;
+        }
+
+        if (contains(number, hash))
+        {
+            // Drop the entries above the common ancestor.
+            unsigned const divergent = m_newestNumber - number;
+            m_newest = (m_newest + c_size - divergent) % c_size;
+            m_count -= divergent;
+        }
+        else
+            m_count = 0;
+
+        for (auto it = suffix.rbegin(); it != suffix.rend(); ++it)
+        {
+            m_newest = (m_newest + 1) % c_size;
+            m_ring[m_newest] = *it;
+            if (m_count < c_size)
+                ++m_count;
+        }
+        m_newestNumber = mostRecentNumber;
+
+        // Refill the oldest entries, dropped by a reorganisation or a rewind.
+        while (m_count < c_size && m_newestNumber + 1 > m_count)
+        {
+            h256 const& oldest = m_ring[(m_newest + c_size - (m_count - 1)) % c_size];
+            m_ring[(m_newest + c_size - m_count) % c_size] = m_bc.details(oldest).parent;
+            ++m_count;
+        }
+        return true;
+    }
+
     BlockChain const& m_bc;
 
     mutable Mutex m_lastHashesMutex;
-    mutable h256s m_lastHashes;
+    mutable std::array<h256, c_size> m_ring;    ///< Ring buffer of hashes, the newest at m_newest.
+    mutable unsigned m_newest = 0;              ///< Index of the newest hash in m_ring.
+    mutable unsigned m_count = 0;               ///< Number of valid hashes in m_ring.
+    mutable unsigned m_newestNumber = 0;        ///< Block number of the newest hash.
 };
 
 void addBlockInfo(Exception& io_ex, BlockHeader const& _header, bytes&& _blockData)
@@ -306,6 +387,8 @@ void BlockChain::open(fs::path const& _path, WithExisting _we, ProgressCallback
 {
     if (open(_path, _we) != c_minorProtocolVersion || _we == WithExisting::Verify)
         rebuild(_path, _pc);
+    else if (_we == WithExisting::Reindex)
+        reindex(_path, _pc);
 }
 
 void BlockChain::reopen(ChainParams const& _p, WithExisting _we, ProgressCallback const& _pc)
@@ -368,13 +451,7 @@ void BlockChain::rebuild(fs::path const& _path, std::function<void(unsigned, uns
     Block s = genesisBlock(State::openDB(path.string(), m_genesisHash, WithExisting::Kill));
 
     // Clear all memos ready for replay.
-    m_details.clear();
-    m_logBlooms.clear();
-    m_receipts.clear();
-    m_transactionAddresses.clear();
-    m_blockHashes.clear();
-    m_blocksBlooms.clear();
-    m_lastBlockHashes->clear();
+    clearExtrasCaches();
     m_lastBlockHash = genesisHash();
     m_lastBlockNumber = 0;
 
@@ -421,6 +498,246 @@ void BlockChain::rebuild(fs::path const& _path, std::function<void(unsigned, uns
     fs::remove_all(path / fs::path("extras.old"));
 }
 
+void BlockChain::reindex(fs::path const& _path, ProgressCallback const& _progress)
+{
+    if (!db::isDiskDatabase())
+    {
+        cwarn << "In-memory database detected, skipping reindex (since there's no existing database to reindex)";
+        return;
+    }
+    if (chainStartBlockNumber() != 0)
+    {
+        cwarn << "Partial chain detected (starting at #" << chainStartBlockNumber()
+              << "), skipping reindex";
+        return;
+    }
+
+    fs::path path = _path.empty() ? db::databasePath() : _path;
+    fs::path chainPath = path / fs::path(toHex(m_genesisHash.ref().cropped(0, 4)));
+    fs::path extrasPath = chainPath / fs::path(toString(c_databaseVersion));
+
+    unsigned const originalNumber = m_lastBlockNumber;
+
+    // Keep extras DB around, but under a temp name
+    m_extrasDB.reset();
+    DEV_IGNORE_EXCEPTIONS(fs::remove_all(extrasPath / fs::path("extras.old")));
+    fs::rename(extrasPath / fs::path("extras"), extrasPath / fs::path("extras.old"));
+    std::unique_ptr<db::DatabaseFace> oldExtrasDB(db::DBFactory::create(extrasPath / fs::path("extras.old")));
+    m_extrasDB = db::DBFactory::create(extrasPath / fs::path("extras"));
+
+    clearExtrasCaches();
+
+    // Collect the canonical route from the old block hash and details indices. These are small
+    // records, so the chain of parent links is cheap to validate serially.
+    h256s hashes{m_genesisHash};
+    for (unsigned n = 1; n <= originalNumber; ++n)
+    {
+        // Direct lookups, the memos would only grow with records which are rewritten below.
+        std::string const hashRLP = oldExtrasDB->lookup(toSlice(n, ExtraBlockHash));
+        h256 const h = hashRLP.empty() ? h256() : BlockHash(RLP(hashRLP)).value;
+        std::string const detailsRLP = h ? oldExtrasDB->lookup(toSlice(h, ExtraDetails)) : std::string();
+        BlockDetails const d = detailsRLP.empty() ? NullBlockDetails : BlockDetails(RLP(detailsRLP));
+        if (!h || d.number != n || d.parent != hashes.back() || !m_blocksDB->exists(toSlice(h)))
+        {
+            cwarn << "Canonical chain broken at #" << n << " (" << h << "); reindexing up to #"
+                  << (n - 1);
+            break;
+        }
+        hashes.push_back(h);
+    }
+
+    unsigned const last = hashes.size() - 1;
+    std::vector<u256> difficulties(hashes.size());
+    difficulties[0] = genesis().difficulty();
+
+    // Work items are aligned to the span of the top-level blocks blooms chunk, so that each chunk is
+    // written by exactly one worker.
+    unsigned const itemSize = c_bloomIndexSize * c_bloomIndexSize * 16;
+    unsigned const items = last / itemSize + 1;
+    std::atomic<unsigned> nextItem{0};
+    std::atomic<unsigned> done{0};
+    std::atomic<unsigned> firstBad{last + 1};
+    // One past the last block whose indices each work item wrote.
+    std::vector<unsigned> writtenEnd(items, 0);
+    Mutex x_progress;
+
+    auto worker = [&]() {
+        for (unsigned item = nextItem++; item < items; item = nextItem++)
+        {
+            unsigned const begin = max(item * itemSize, 1u);
+            unsigned const end = min((item + 1) * itemSize, last + 1);
+            std::unique_ptr<db::WriteBatchFace> batch = m_extrasDB->createWriteBatch();
+            std::map<h256, BlocksBlooms> blooms;
+            unsigned n = begin;
+            try
+            {
+                for (; n < end && n < firstBad; ++n)
+                {
+                    std::string const b = m_blocksDB->lookup(toSlice(hashes[n]));
+                    bytesConstRef const blockRef(&b);
+                    RLP const blockRLP(blockRef);
+                    BlockHeader const header(blockRef);
+                    if (header.hash() != hashes[n] || header.parentHash() != hashes[n - 1])
+                        break;
+                    difficulties[n] = header.difficulty();
+
+                    std::string const receipts =
+                        oldExtrasDB->lookup(toSlice(hashes[n], ExtraReceipts));
+                    RLP const receiptsRLP(receipts);
+                    if (receipts.empty() || receiptsRLP.itemCount() != blockRLP[1].itemCount())
+                        break;
+                    batch->insert(toSlice(hashes[n], ExtraReceipts), db::Slice(receipts));
+
+                    BlockLogBlooms blb;
+                    for (auto i: receiptsRLP)
+                        blb.blooms.push_back(TransactionReceipt(i.data()).bloom());
+                    batch->insert(
+                        toSlice(hashes[n], ExtraLogBlooms), (db::Slice)dev::ref(blb.rlp()));
+
+                    TransactionAddress ta;
+                    ta.blockHash = hashes[n];
+                    for (ta.index = 0; ta.index < blockRLP[1].itemCount(); ++ta.index)
+                        batch->insert(
+                            toSlice(sha3(blockRLP[1][ta.index].data()), ExtraTransactionAddress),
+                            (db::Slice)dev::ref(ta.rlp()));
+                    batch->insert(toSlice(h256(n), ExtraBlockHash),
+                        (db::Slice)dev::ref(BlockHash(hashes[n]).rlp()));
+
+                    LogBloom blockBloom = header.logBloom();
+                    blockBloom.shiftBloom<3>(sha3(header.author().ref()));
+                    for (unsigned level = 0, index = n; level < c_bloomIndexLevels; level++, index /= c_bloomIndexSize)
+                        blooms[chunkId(level, index / c_bloomIndexSize)].blooms[index % c_bloomIndexSize] |= blockBloom;
+                }
+            }
+            catch (Exception const& _e)
+            {
+                cwarn << "Bad block #" << n << " while reindexing: "
+                      << boost::diagnostic_information(_e);
+            }
+            writtenEnd[item] = n;
+            if (n < end)
+            {
+                // Keep the lowest failure, the chain will be cut just before it.
+                unsigned bad = firstBad;
+                while (n < bad && !firstBad.compare_exchange_weak(bad, n)) {}
+            }
+
+            for (auto const& i: blooms)
+                batch->insert(toSlice(i.first, ExtraBlocksBlooms), (db::Slice)dev::ref(i.second.rlp()));
+            m_extrasDB->commit(std::move(batch));
+
+            unsigned const d = done += end - begin;
+            if (_progress)
+                DEV_GUARDED(x_progress)
+                    _progress(d, last);
+        }
+    };
+
+    Timer t;
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < max(std::thread::hardware_concurrency(), 1u); ++i)
+        workers.emplace_back([&]() {
+            setThreadName("reindex");
+            worker();
+        });
+    worker();
+    for (auto& w: workers)
+        w.join();
+
+    // Total difficulties depend on all ancestors, so the details go in a final serial pass.
+    unsigned const head = firstBad - 1;
+    std::unique_ptr<db::WriteBatchFace> batch = m_extrasDB->createWriteBatch();
+    if (head < last)
+        removeIndicesAbove(head, hashes, writtenEnd, itemSize, *batch);
+
+    u256 td = 0;
+    for (unsigned n = 0; n <= head; ++n)
+    {
+        td += difficulties[n];
+        BlockDetails const details(n, td, n ? hashes[n - 1] : h256(), n < head ? h256s{hashes[n + 1]} : h256s{});
+        batch->insert(toSlice(hashes[n], ExtraDetails), (db::Slice)dev::ref(details.rlp()));
+        if (!((n + 1) % 10000))
+        {
+            m_extrasDB->commit(std::move(batch));
+            batch = m_extrasDB->createWriteBatch();
+        }
+    }
+    batch->insert(db::Slice("best"), db::Slice((char const*)&hashes[head], 32));
+    m_extrasDB->commit(std::move(batch));
+
+    DEV_WRITE_GUARDED(x_lastBlockHash)
+    {
+        m_lastBlockHash = hashes[head];
+        m_lastBlockNumber = head;
+    }
+    m_lastBlockHashes->clear();
+
+    cnote << "Reindexed " << head << " blocks in " << t.elapsed() << "s";
+
+    oldExtrasDB.reset();
+    fs::remove_all(extrasPath / fs::path("extras.old"));
+}
+
+void BlockChain::removeIndicesAbove(unsigned _head, h256s const& _hashes,
+    std::vector<unsigned> const& _writtenEnd, unsigned _itemSize, db::WriteBatchFace& _batch)
+{
+    // The work item holding the first bad block stopped before it. The ones after it are written
+    // up to _writtenEnd, and their blooms chunks hold only blocks above the new head.
+    unsigned const firstDropped = (_head / _itemSize + 1) * _itemSize;
+    for (unsigned item = _head / _itemSize + 1; item < _writtenEnd.size(); ++item)
+        for (unsigned n = item * _itemSize; n < _writtenEnd[item]; ++n)
+        {
+            _batch.kill(toSlice(h256(n), ExtraBlockHash));
+            _batch.kill(toSlice(_hashes[n], ExtraReceipts));
+            _batch.kill(toSlice(_hashes[n], ExtraLogBlooms));
+            std::string const b = m_blocksDB->lookup(toSlice(_hashes[n]));
+            for (auto const& tx: RLP(b)[1])
+                _batch.kill(toSlice(sha3(tx.data()), ExtraTransactionAddress));
+        }
+
+    unsigned span = c_bloomIndexSize;
+    for (unsigned level = 0; level < c_bloomIndexLevels; ++level, span *= c_bloomIndexSize)
+        for (unsigned c = firstDropped / span; c * span < _hashes.size(); ++c)
+            _batch.kill(toSlice(chunkId(level, c), ExtraBlocksBlooms));
+}
+
+void BlockChain::reexecute(OverlayDB const& _stateDB, ProgressCallback const& _progress)
+{
+    unsigned const head = number();
+    if (_stateDB.exists(info().stateRoot()))
+        return;
+
+    // Make sure the genesis state is there to start from.
+    genesisBlock(_stateDB);
+
+    // Every re-executed block commits its state, so an interrupted run resumes after the highest
+    // block whose state is there. Nothing outside the state database has to survive --reindex.
+    // The blocks looked at here are the ones to re-execute anyway.
+    unsigned from = head ? head - 1 : 0;
+    while (from > 0 && !_stateDB.exists(info(numberHash(from)).stateRoot()))
+        --from;
+    cnote << "Re-executing blocks #" << (from + 1) << " to #" << head;
+
+    Timer t;
+    for (unsigned n = from + 1; n <= head; ++n)
+    {
+        bytes const b = block(numberHash(n));
+        Block s(*this, _stateDB);
+        s.enactOn(verifyBlock(&b, m_onBad, ImportRequirements::TransactionBasic), *this);
+        s.cleanup();
+
+        if (!(n % c_reexecuteLogInterval))
+        {
+            LOG(m_logger) << c_reexecuteLogInterval << " blocks re-executed in " << t.elapsed()
+                          << "s";
+            t.restart();
+        }
+
+        if (_progress)
+            _progress(n, head);
+    }
+}
+
 string BlockChain::dumpDatabase() const
 {
     ostringstream oss;
@@ -690,23 +1007,34 @@ ImportRoute BlockChain::import(VerifiedBlockRef const& _block, OverlayDB const&
     performanceLogger.onStageFinished("preliminaryChecks");
 
     BlockReceipts br;
+    bytes stateDiff;
     u256 td;
     try
     {
         // Check transactions are valid and that they result in a state equivalent to our state_root.
         // Get total difficulty increase and update state, checking it.
         Block s(*this, _db);
+        // Diffs of blocks already out of the history window would never be pruned.
+        bool const recordStateDiff =
+            m_stateDiffHistory && _block.info.number() + m_stateDiffHistory > number();
+        if (recordStateDiff)
+            s.mutableState().startStateDiff();
         auto tdIncrease = s.enactOn(_block, *this);
 
         for (unsigned i = 0; i < s.pending().size(); ++i)
             br.receipts.push_back(s.receipt(i));
 
-        s.cleanup();
+        if (recordStateDiff)
+            stateDiff = s.mutableState().takeStateDiff().rlp();
 
         td = pd.totalDifficulty + tdIncrease;
 
         performanceLogger.onStageFinished("enactment");
 
+        s.cleanup();
+
+        performanceLogger.onStageFinished("stateCommit");
+
 #if ETH_PARANOIA
         checkConsistency();
 #endif // ETH_PARANOIA
@@ -727,7 +1055,7 @@ ImportRoute BlockChain::import(VerifiedBlockRef const& _block, OverlayDB const&
 
     // All ok - insert into DB
     bytes const receipts = br.rlp();
-    return insertBlockAndExtras(_block, ref(receipts), td, performanceLogger);
+    return insertBlockAndExtras(_block, ref(receipts), ref(stateDiff), td, performanceLogger);
 }
 
 ImportRoute BlockChain::insertWithoutParent(bytes const& _block, bytesConstRef _receipts, u256 const& _totalDifficulty)
@@ -740,7 +1068,7 @@ ImportRoute BlockChain::insertWithoutParent(bytes const& _block, bytesConstRef _
     checkBlockTimestamp(block.info);
 
     ImportPerformanceLogger performanceLogger;
-    return insertBlockAndExtras(block, _receipts, _totalDifficulty, performanceLogger);
+    return insertBlockAndExtras(block, _receipts, {}, _totalDifficulty, performanceLogger);
 }
 
 void BlockChain::checkBlockIsNew(VerifiedBlockRef const& _block) const
@@ -764,7 +1092,9 @@ void BlockChain::checkBlockTimestamp(BlockHeader const& _header) const
     }
 }
 
-ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, bytesConstRef _receipts, u256 const& _totalDifficulty, ImportPerformanceLogger& _performanceLogger)
+ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block,
+    bytesConstRef _receipts, bytesConstRef _stateDiff, u256 const& _totalDifficulty,
+    ImportPerformanceLogger& _performanceLogger)
 {
     std::unique_ptr<db::WriteBatchFace> blocksWriteBatch = m_blocksDB->createWriteBatch();
     std::unique_ptr<db::WriteBatchFace> extrasWriteBatch = m_extrasDB->createWriteBatch();
@@ -801,6 +1131,21 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
 
         extrasWriteBatch->insert(toSlice(_block.info.hash(), ExtraReceipts), (db::Slice)_receipts);
 
+        if (!_stateDiff.empty())
+        {
+            extrasWriteBatch->insert(
+                toSlice(_block.info.hash(), ExtraStateDiffs), (db::Slice)_stateDiff);
+
+            // Index the diffs by number as well, so that the ones of fork blocks get pruned.
+            h256 const numberKey(_block.info.number());
+            std::string const indexed =
+                m_extrasDB->lookup(toSlice(numberKey, ExtraStateDiffHashes));
+            h256s hashes = indexed.empty() ? h256s() : RLP(indexed).toVector<h256>();
+            hashes.push_back(_block.info.hash());
+            extrasWriteBatch->insert(
+                toSlice(numberKey, ExtraStateDiffHashes), (db::Slice)dev::ref(rlp(hashes)));
+        }
+
         _performanceLogger.onStageFinished("writing");
     }
     catch (Exception& ex)
@@ -877,6 +1222,7 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
                     toSlice(h, ExtraBlocksBlooms), (db::Slice)dev::ref(m_blocksBlooms[h].rlp()));
             extrasWriteBatch->insert(toSlice(h256(tbi.number()), ExtraBlockHash),
                 (db::Slice)dev::ref(BlockHash(tbi.hash()).rlp()));
+
         }
 
         // FINALLY! change our best hash.
@@ -886,6 +1232,8 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
             isImportedAndBest = true;
         }
 
+        pruneStateDiffs(details(last).number, newLastBlockNumber, *extrasWriteBatch);
+
         LOG(m_logger) << "   Imported and best " << _totalDifficulty << " (#"
                       << _block.info.number() << "). Has "
                       << (details(_block.info.parentHash()).children.size() - 1)
@@ -898,6 +1246,8 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
                             << _block.info.number() << ")";
     }
 
+    _performanceLogger.onStageFinished("route");
+
     try
     {
         m_blocksDB->commit(std::move(blocksWriteBatch));
@@ -920,6 +1270,8 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
         exit(-1);
     }
 
+    _performanceLogger.onStageFinished("dbWrite");
+
 #if ETH_PARANOIA
     if (isKnown(_block.info.hash()) && !details(_block.info.hash()))
     {
@@ -976,9 +1328,8 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
         {"transactions", toString(_block.transactions.size())},
         {"gasUsed", toString(_block.info.gasUsed())}
     });
-
-    if (!route.empty())
-        noteCanonChanged();
+    if (m_onImportPerformance)
+        m_onImportPerformance(_block.info, _performanceLogger.stages());
 
     if (isImportedAndBest && m_onBlockImport)
         m_onBlockImport(_block.info);
@@ -996,6 +1347,41 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
     return ImportRoute{dead, fresh, _block.transactions};
 }
 
+StateDiff BlockChain::stateDiff(h256 const& _hash) const
+{
+    std::string const s = m_extrasDB->lookup(toSlice(_hash, ExtraStateDiffs));
+    if (s.empty())
+        return NullStateDiff;
+    return StateDiff(RLP(s));
+}
+
+bool BlockChain::applyStateDiffs(State& io_state, h256 const& _from, h256 const& _to) const
+{
+    h256s route;
+    h256 common;
+    unsigned commonIndex;
+    tie(route, common, commonIndex) = treeRoute(_from, _to, false);
+    if (!common)
+        return false;
+
+    // Fetch all the diffs before touching the state so that a missing one doesn't leave it
+    // half-way.
+    vector<StateDiff> diffs;
+    diffs.reserve(route.size());
+    for (auto const& h: route)
+    {
+        diffs.push_back(stateDiff(h));
+        if (!diffs.back())
+            return false;
+    }
+
+    // The route first descends from _from to the common ancestor, then ascends to _to.
+    for (unsigned i = 0; i < diffs.size(); ++i)
+        io_state.applyStateDiff(diffs[i],
+            i < commonIndex ? StateDiffDirection::Revert : StateDiffDirection::Forward);
+    return true;
+}
+
 void BlockChain::clearBlockBlooms(unsigned _begin, unsigned _end)
 {
     //   ... c c c c c c c c c c C o o o o o o
@@ -1088,6 +1474,24 @@ void BlockChain::rescue(OverlayDB const& _db)
     rewind(l);
 }
 
+void BlockChain::pruneStateDiffs(
+    unsigned _oldHead, unsigned _newHead, db::WriteBatchFace& _batch) const
+{
+    // The window holds the numbers above head - history.
+    unsigned const history = m_stateDiffHistory;
+    if (!history || _newHead < history)
+        return;
+    for (unsigned n = _oldHead >= history ? _oldHead - history + 1 : 0; n <= _newHead - history; ++n)
+    {
+        std::string const indexed = m_extrasDB->lookup(toSlice(h256(n), ExtraStateDiffHashes));
+        if (indexed.empty())
+            continue;
+        for (auto const& h : RLP(indexed))
+            _batch.kill(toSlice(h.toHash<h256>(), ExtraStateDiffs));
+        _batch.kill(toSlice(h256(n), ExtraStateDiffHashes));
+    }
+}
+
 void BlockChain::rewind(unsigned _newHead)
 {
     DEV_WRITE_GUARDED(x_lastBlockHash)
@@ -1109,7 +1513,6 @@ void BlockChain::rewind(unsigned _newHead)
             cwarn << "Fail writing to extras database. Bombing out.";
             exit(-1);
         }
-        noteCanonChanged();
     }
 }
 
@@ -1301,6 +1704,23 @@ void BlockChain::checkConsistency()
     });
 }
 
+void BlockChain::clearExtrasCaches()
+{
+    DEV_WRITE_GUARDED(x_details)
+        m_details.clear();
+    DEV_WRITE_GUARDED(x_logBlooms)
+        m_logBlooms.clear();
+    DEV_WRITE_GUARDED(x_receipts)
+        m_receipts.clear();
+    DEV_WRITE_GUARDED(x_transactionAddresses)
+        m_transactionAddresses.clear();
+    DEV_WRITE_GUARDED(x_blockHashes)
+        m_blockHashes.clear();
+    DEV_WRITE_GUARDED(x_blocksBlooms)
+        m_blocksBlooms.clear();
+    m_lastBlockHashes->clear();
+}
+
 void BlockChain::clearCachesDuringChainReversion(unsigned _firstInvalid)
 {
     unsigned end = m_lastBlockNumber + 1;
@@ -1476,6 +1896,15 @@ bytes BlockChain::headerData(h256 const& _hash) const
     return BlockHeader::extractHeader(&m_blocks[_hash]).data().toBytes();
 }
 
+bytes BlockChain::receiptsData(h256 const& _hash) const
+{
+    string const d = m_extrasDB->lookup(toSlice(_hash, ExtraReceipts));
+    if (d.empty())
+        // The genesis block has no receipts stored.
+        return _hash == m_genesisHash ? rlpList() : bytes();
+    return bytes(d.begin(), d.end());
+}
+
 Block BlockChain::genesisBlock(OverlayDB const& _db) const
 {
     h256 r = BlockHeader(m_params.genesisBlock()).stateRoot();
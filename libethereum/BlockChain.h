@@ -86,7 +86,9 @@ enum {
     ExtraTransactionAddress,
     ExtraLogBlooms,
     ExtraReceipts,
-    ExtraBlocksBlooms
+    ExtraBlocksBlooms,
+    ExtraStateDiffs,
+    ExtraStateDiffHashes
 };
 
 using ProgressCallback = std::function<void(unsigned, unsigned)>;
@@ -166,6 +168,10 @@ public:
     BlockReceipts receipts(h256 const& _hash) const { return queryExtras<BlockReceipts, ExtraReceipts>(_hash, m_receipts, x_receipts, NullBlockReceipts); }
     BlockReceipts receipts() const { return receipts(currentHash()); }
 
+    /// Get the RLP list of a block's receipts as stored, without decoding it. Empty if the block is
+    /// unknown. Thread-safe.
+    bytes receiptsData(h256 const& _hash) const;
+
     /// Get the transaction by block hash and index;
     TransactionReceipt transactionReceipt(h256 const& _blockHash, unsigned _i) const { return receipts(_blockHash).receipts[_i]; }
 
@@ -185,6 +191,20 @@ public:
 
     LastBlockHashesFace const& lastBlockHashes() const { return *m_lastBlockHashes;  }
 
+    /// Get the state changes made by a block, if they were recorded on import. Thread-safe.
+    /// @returns NullStateDiff if the diff of the block is not available.
+    StateDiff stateDiff(h256 const& _hash) const;
+
+    /// Record the state diff of every imported block, canonical or not, and keep the diffs of
+    /// the blocks within @a _blocks of the chain head by number. 0 (the default) disables recording.
+    void setStateDiffHistory(unsigned _blocks) { m_stateDiffHistory = _blocks; }
+    unsigned stateDiffHistory() const { return m_stateDiffHistory; }
+
+    /// Move @a io_state from the state of block @a _from to the state of block @a _to by reverting
+    /// and applying recorded state diffs along the route between them, without re-executing blocks.
+    /// @returns false if a diff along the route is not available; @a io_state must then be reset.
+    bool applyStateDiffs(State& io_state, h256 const& _from, h256 const& _to) const;
+
     /** Get the block blooms for a number of blocks. Thread-safe.
      * @returns the object pertaining to the blocks:
      * level 0:
@@ -239,6 +259,17 @@ public:
     /// Will call _progress with the progress in this operation first param done, second total.
     void rebuild(boost::filesystem::path const& _path, ProgressCallback const& _progress = std::function<void(unsigned, unsigned)>());
 
+    /// Rebuild the extras database (details, receipts, log blooms, transaction addresses and block
+    /// hashes) of the canonical chain from the stored blocks and receipts, on all cores and
+    /// without executing any transaction. The state database is left untouched.
+    /// Will call _progress with the progress in this operation first param done, second total.
+    void reindex(boost::filesystem::path const& _path, ProgressCallback const& _progress = ProgressCallback());
+
+    /// Re-execute the canonical blocks whose state is missing from @a _stateDB, starting after the
+    /// highest block whose state is present, so that an interrupted run resumes where it stopped.
+    /// Does nothing if the state of the head block is present.
+    void reexecute(OverlayDB const& _stateDB, ProgressCallback const& _progress = ProgressCallback());
+
     /// Alter the head of the chain to some prior block along it.
     void rewind(unsigned _newHead);
 
@@ -294,6 +325,9 @@ public:
     /// Change the function that is called when a new block is imported
     void setOnBlockImport(std::function<void(BlockHeader const&)> _t) { m_onBlockImport = _t; }
 
+    /// Change the function that is called with the stage timings (in seconds) of every imported block
+    void setOnImportPerformance(std::function<void(BlockHeader const&, std::unordered_map<std::string, double> const&)> _t) { m_onImportPerformance = _t; }
+
     /// Get a pre-made genesis State object.
     Block genesisBlock(OverlayDB const& _db) const;
 
@@ -326,7 +360,9 @@ private:
     /// Finalise everything and close the database.
     void close();
 
-    ImportRoute insertBlockAndExtras(VerifiedBlockRef const& _block, bytesConstRef _receipts, u256 const& _totalDifficulty, ImportPerformanceLogger& _performanceLogger);
+    ImportRoute insertBlockAndExtras(VerifiedBlockRef const& _block, bytesConstRef _receipts,
+        bytesConstRef _stateDiff, u256 const& _totalDifficulty,
+        ImportPerformanceLogger& _performanceLogger);
     void checkBlockIsNew(VerifiedBlockRef const& _block) const;
     void checkBlockTimestamp(BlockHeader const& _header) const;
 
@@ -361,6 +397,18 @@ private:
 
     void checkConsistency();
 
+    /// Clears the memos of the extras database.
+    void clearExtrasCaches();
+
+    /// Removes from @a _batch the indices reindex() wrote for the blocks above @a _head, its
+    /// work items of @a _itemSize blocks having written up to @a _writtenEnd.
+    void removeIndicesAbove(unsigned _head, h256s const& _hashes,
+        std::vector<unsigned> const& _writtenEnd, unsigned _itemSize, db::WriteBatchFace& _batch);
+
+    /// Removes from @a _batch the state diffs of all blocks, canonical or not, which leave the
+    /// history window as the head moves from number @a _oldHead to @a _newHead.
+    void pruneStateDiffs(unsigned _oldHead, unsigned _newHead, db::WriteBatchFace& _batch) const;
+
     /// Clears all caches from the tip of the chain up to (including) _firstInvalid.
     /// These include the blooms, the block hashes and the transaction lookup tables.
     void clearCachesDuringChainReversion(unsigned _firstInvalid);
@@ -390,9 +438,11 @@ private:
     void noteUsed(uint64_t const& _h, unsigned _extra = (unsigned)-1) const { (void)_h; (void)_extra; } // don't note non-hash types
     std::chrono::system_clock::time_point m_lastCollection;
 
-    void noteCanonChanged() const { m_lastBlockHashes->clear(); }
     std::unique_ptr<LastBlockHashesFace> m_lastBlockHashes;
 
+    /// Number of the most recent canonical blocks for which state diffs are kept, 0 if disabled.
+    std::atomic<unsigned> m_stateDiffHistory{0};
+
     void updateStats() const;
     mutable Statistics m_lastStats;
 
@@ -414,6 +464,7 @@ private:
 
     std::function<void(Exception&)> m_onBad;                                    ///< Called if we have a block that doesn't verify.
     std::function<void(BlockHeader const&)> m_onBlockImport;                                        ///< Called if we have imported a new block into the db
+    std::function<void(BlockHeader const&, std::unordered_map<std::string, double> const&)> m_onImportPerformance; ///< Called with the stage timings of each imported block
 
     boost::filesystem::path m_dbPath;
 
@@ -209,8 +209,7 @@ void BlockChainSync::onPeerStatus(EthereumPeer const& _peer)
     if (peerSessionInfo->clientVersion.find("/v0.7.0/") != string::npos)
         disconnectReason = "Blacklisted client version.";
     else
-        disconnectReason = _peer.validate(
-            host().chain().genesisHash(), host().protocolVersion(), host().networkId());
+        disconnectReason = _peer.validate(host().chain().genesisHash(), host().networkId());
 
     if (!disconnectReason.empty())
     {
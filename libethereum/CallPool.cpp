@@ -0,0 +1,86 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "CallPool.h"
+
+#include <libdevcore/Log.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+CallPool::Limits CallPool::defaultLimits()
+{
+    unsigned const workers = max(thread::hardware_concurrency() / 2, 1U);
+    return Limits{workers, workers * 16, 50000000, chrono::seconds(5)};
+}
+
+CallPool::CallPool(Limits const& _limits) : m_limits(_limits)
+{
+    for (unsigned i = 0; i < m_limits.workers; ++i)
+        m_workers.emplace_back([=]() {
+            setThreadName("call" + toString(i));
+            this->workerBody();
+        });
+}
+
+CallPool::~CallPool()
+{
+    DEV_GUARDED(x_queue)
+        m_deleting = true;
+
+    m_moreToRun.notify_all();
+    for (auto& i: m_workers)
+        i.join();
+}
+
+CallPool::Status CallPool::status() const
+{
+    Status ret;
+    DEV_GUARDED(x_queue)
+        ret.queued = m_queue.size();
+    ret.running = m_running;
+    ret.completed = m_completed;
+    ret.rejected = m_rejected;
+    ret.timedOut = m_timedOut;
+    return ret;
+}
+
+void CallPool::enqueue(function<void()>&& _run)
+{
+    {
+        Guard l(x_queue);
+        if (m_queue.size() >= m_limits.queue)
+        {
+            ++m_rejected;
+            BOOST_THROW_EXCEPTION(CallPoolBusy());
+        }
+        m_queue.push_back(Job{move(_run), chrono::steady_clock::now() + m_limits.timeout});
+    }
+    m_moreToRun.notify_one();
+}
+
+void CallPool::workerBody()
+{
+    while (!m_deleting)
+    {
+        Job job;
+        {
+            unique_lock<Mutex> l(x_queue);
+            m_moreToRun.wait(l, [&]() { return !m_queue.empty() || m_deleting; });
+            if (m_deleting)
+                return;
+            job = move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        // Nobody waits for the result any more.
+        if (chrono::steady_clock::now() > job.deadline)
+            continue;
+
+        ++m_running;
+        job.run();
+        --m_running;
+    }
+}
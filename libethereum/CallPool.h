@@ -0,0 +1,146 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Pool of threads executing read-only calls (eth_call, eth_estimateGas) concurrently.
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/Exceptions.h>
+#include <libdevcore/Guards.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+DEV_SIMPLE_EXCEPTION(CallPoolBusy);
+DEV_SIMPLE_EXCEPTION(CallTimedOut);
+
+/**
+ * @brief Runs read-only calls on a fixed set of worker threads.
+ *
+ * Each call works on its own copy of the block it is pinned at, so calls run independently of
+ * each other and of block import. A call is rejected when too many are already queued, and its
+ * caller stops waiting for it after a timeout. The timeout is a deadline, not a cancellation: a
+ * call still queued by then is never started, but a running call is not interrupted and keeps its
+ * worker until it ends, bounded only by its gas limit.
+ * @threadsafe
+ */
+class CallPool
+{
+public:
+    struct Limits
+    {
+        unsigned workers;                   ///< Number of worker threads.
+        size_t queue;                       ///< Maximum number of calls waiting for a worker.
+        u256 gas;                           ///< Maximum gas a single call may use.
+        std::chrono::milliseconds timeout;  ///< Maximum time a caller waits for its call to end.
+    };
+
+    struct Status
+    {
+        size_t queued;
+        size_t running;
+        uint64_t completed;
+        uint64_t rejected;
+        uint64_t timedOut;
+    };
+
+    /// @returns the limits suited to this machine, leaving half of the cores to block import.
+    static Limits defaultLimits();
+
+    explicit CallPool(Limits const& _limits = defaultLimits());
+    ~CallPool();
+
+    CallPool(CallPool const&) = delete;
+    CallPool& operator=(CallPool const&) = delete;
+
+    /// Runs @a _call on a worker and waits for its result. @a _call must own everything it uses,
+    /// as it may still run after the caller gave up waiting.
+    /// @throws CallPoolBusy if the queue is full, CallTimedOut if the result is not ready in time.
+    template <class F>
+    auto run(F _call) -> decltype(_call())
+    {
+        using Result = decltype(_call());
+        auto promised = std::make_shared<std::promise<Result>>();
+        std::future<Result> result = promised->get_future();
+        enqueue([this, promised, _call]() mutable {
+            try
+            {
+                complete(*promised, _call);
+            }
+            catch (...)
+            {
+                ++m_completed;
+                promised->set_exception(std::current_exception());
+            }
+        });
+
+        if (result.wait_for(m_limits.timeout) != std::future_status::ready)
+        {
+            ++m_timedOut;
+            BOOST_THROW_EXCEPTION(CallTimedOut());
+        }
+        return result.get();
+    }
+
+    /// @returns the limits the pool was created with.
+    Limits const& limits() const { return m_limits; }
+
+    /// @returns the queue depth and the counters of the pool.
+    Status status() const;
+
+private:
+    struct Job
+    {
+        std::function<void()> run;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    /// Runs @a _call and fulfils @a _result, counting the call as completed before its caller can
+    /// see the result.
+    template <class R, class F>
+    void complete(std::promise<R>& _result, F& _call)
+    {
+        R ret = _call();
+        ++m_completed;
+        _result.set_value(std::move(ret));
+    }
+    template <class F>
+    void complete(std::promise<void>& _result, F& _call)
+    {
+        _call();
+        ++m_completed;
+        _result.set_value();
+    }
+
+    void enqueue(std::function<void()>&& _run);
+    void workerBody();
+
+    Limits const m_limits;
+
+    mutable Mutex x_queue;
+    std::condition_variable m_moreToRun;  ///< Signaled when m_queue has a new job.
+    std::deque<Job> m_queue;              ///< Calls waiting for a worker.
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_deleting = {false};
+
+    std::atomic<size_t> m_running = {0};
+    std::atomic<uint64_t> m_completed = {0};
+    std::atomic<uint64_t> m_rejected = {0};
+    std::atomic<uint64_t> m_timedOut = {0};
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -126,6 +126,8 @@ void Client::init(p2p::Host& _extNet, fs::path const& _dbPath,
 
     if (_forceAction == WithExisting::Rescue)
         bc().rescue(m_stateDB);
+    else if (_forceAction == WithExisting::Reindex)
+        bc().reexecute(m_stateDB);
 
     m_gp->update(bc());
 
@@ -135,6 +137,9 @@ void Client::init(p2p::Host& _extNet, fs::path const& _dbPath,
         auto ethCapability = make_shared<EthereumCapability>(
             _extNet.capabilityHost(), bc(), m_stateDB, m_tq, m_bq, _networkId);
         _extNet.registerCapability(ethCapability);
+        // Peers supporting it are sent transaction hashes instead of whole transactions.
+        _extNet.registerCapability(
+            ethCapability, ethCapability->name(), c_transactionHashesVersion);
         m_host = ethCapability;
     }
 
@@ -849,8 +854,13 @@ bool Client::submitSealed(bytes const& _header)
 void Client::rewind(unsigned _n)
 {
     executeInMainThread([=]() {
+        // Report the rewound blocks as dead, so that their transactions are requeued and the state
+        // is brought back along the chain, by the recorded state diffs where the root is gone.
+        ImportRoute route;
+        for (unsigned i = bc().number(); i > _n; --i)
+            route.deadBlocks.push_back(bc().numberHash(i));
         bc().rewind(_n);
-        onChainChanged(ImportRoute());
+        onChainChanged(route);
     });
 
     for (unsigned i = 0; i < 10; ++i)
@@ -871,8 +881,14 @@ void Client::rewind(unsigned _n)
 
 h256 Client::submitTransaction(TransactionSkeleton const& _t, Secret const& _secret)
 {
-    TransactionSkeleton ts = populateTransactionWithDefaults(_t);
-    ts.from = toAddress(_secret);
+    // The default nonce follows the ones in the queue, so it's only right once the previous
+    // transaction of the sender has been imported.
+    Address const from = toAddress(_secret);
+    Guard l(x_submitBySender[from[0] % x_submitBySender.size()]);
+
+    TransactionSkeleton ts(_t);
+    ts.from = from;
+    ts = populateTransactionWithDefaults(ts);
     Transaction t(ts, _secret);
     return importTransaction(t);
 }
@@ -896,9 +912,12 @@ h256 Client::importTransaction(Transaction const& _t)
         case ImportResult::ZeroSignature:
             BOOST_THROW_EXCEPTION(ZeroSignatureTransaction());
         case ImportResult::OverbidGasPrice:
+        case ImportResult::QueueFull:
             BOOST_THROW_EXCEPTION(GasPriceTooLow());
         case ImportResult::AlreadyKnown:
             BOOST_THROW_EXCEPTION(PendingTransactionAlreadyExists());
+        case ImportResult::TooManyFromSender:
+            BOOST_THROW_EXCEPTION(TooManyPendingTransactions());
         case ImportResult::AlreadyInChain:
             BOOST_THROW_EXCEPTION(TransactionAlreadyInChain());
         default:
@@ -914,15 +933,27 @@ ExecutionResult Client::call(Address const& _from, u256 _value, Address _dest, b
     ExecutionResult ret;
     try
     {
-        Block temp = blockByNumber(_blockNumber);
-        u256 nonce = max<u256>(temp.transactionsFrom(_from), m_tq.maxNonce(_from));
-        u256 gas = _gas == Invalid256 ? gasLimitRemaining() : _gas;
+        // The call works on its own copy of the block, so that it doesn't hold any client lock
+        // while it runs on the call pool.
+        auto temp = make_shared<Block>(blockByNumber(_blockNumber));
+        u256 nonce = max<u256>(temp->transactionsFrom(_from), m_tq.maxNonce(_from));
+        u256 gas = min(_gas == Invalid256 ? gasLimitRemaining() : _gas, m_callPool.limits().gas);
         u256 gasPrice = _gasPrice == Invalid256 ? gasBidPrice() : _gasPrice;
         Transaction t(_value, gasPrice, gas, _dest, _data, nonce);
         t.forceSender(_from);
-        if (_ff == FudgeFactor::Lenient)
-            temp.mutableState().addBalance(_from, (u256)(t.gas() * t.gasPrice() + t.value()));
-        ret = temp.execute(bc().lastBlockHashes(), t, Permanence::Reverted);
+        ret = m_callPool.run([this, temp, t, _from, _ff]() {
+            if (_ff == FudgeFactor::Lenient)
+                temp->mutableState().addBalance(_from, (u256)(t.gas() * t.gasPrice() + t.value()));
+            return temp->execute(bc().lastBlockHashes(), t, Permanence::Reverted);
+        });
+    }
+    catch (CallPoolBusy const&)
+    {
+        throw;
+    }
+    catch (CallTimedOut const&)
+    {
+        throw;
     }
     catch (...)
     {
@@ -930,3 +961,41 @@ ExecutionResult Client::call(Address const& _from, u256 _value, Address _dest, b
     }
     return ret;
 }
+
+pair<u256, ExecutionResult> Client::estimateGas(Address const& _from, u256 _value, Address _dest,
+    bytes const& _data, int64_t _maxGas, u256 _gasPrice, BlockNumber _blockNumber,
+    GasEstimationCallback const& _callback)
+{
+    int64_t const maxGas =
+        _maxGas > m_callPool.limits().gas ? static_cast<int64_t>(m_callPool.limits().gas) : _maxGas;
+
+    // The estimation keeps running after its caller timed out, but must not report progress to a
+    // caller that is gone. The lock makes the caller wait for a report in progress.
+    struct Progress
+    {
+        Mutex x_abandoned;
+        bool abandoned = false;
+    };
+    auto progress = make_shared<Progress>();
+    GasEstimationCallback callback;
+    if (_callback)
+        callback = [progress, _callback](GasEstimationProgress const& _p) {
+            Guard l(progress->x_abandoned);
+            if (!progress->abandoned)
+                _callback(_p);
+        };
+
+    try
+    {
+        return m_callPool.run([=]() {
+            return ClientBase::estimateGas(
+                _from, _value, _dest, _data, maxGas, _gasPrice, _blockNumber, callback);
+        });
+    }
+    catch (CallTimedOut const&)
+    {
+        DEV_GUARDED(progress->x_abandoned)
+            progress->abandoned = true;
+        throw;
+    }
+}
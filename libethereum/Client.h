@@ -24,6 +24,7 @@
 #include "Block.h"
 #include "BlockChain.h"
 #include "BlockChainImporter.h"
+#include "CallPool.h"
 #include "ClientBase.h"
 #include "CommonNet.h"
 #include "StateImporter.h"
@@ -100,8 +101,13 @@ public:
     h256 importTransaction(Transaction const& _t) override;
 
     /// Makes the given call. Nothing is recorded into the state.
+    /// It runs on the call pool, with its gas capped by the pool limits.
     ExecutionResult call(Address const& _secret, u256 _value, Address _dest, bytes const& _data, u256 _gas, u256 _gasPrice, BlockNumber _blockNumber, FudgeFactor _ff = FudgeFactor::Strict) override;
 
+    /// Estimates the gas of a transaction on the call pool, with the gas capped by the pool limits.
+    /// @a _callback is called from a pool thread.
+    std::pair<u256, ExecutionResult> estimateGas(Address const& _from, u256 _value, Address _dest, bytes const& _data, int64_t _maxGas, u256 _gasPrice, BlockNumber _blockNumber, GasEstimationCallback const& _callback) override;
+
     /// Blocks until all pending transactions have been processed.
     void flushTransactions() override;
 
@@ -137,6 +143,8 @@ public:
     /// Get some information on the transaction queue.
     TransactionQueue::Status transactionQueueStatus() const { return m_tq.status(); }
     TransactionQueue::Limits transactionQueueLimits() const { return m_tq.limits(); }
+    /// Get the queue depth and counters of the pool running calls and gas estimations.
+    CallPool::Status callPoolStatus() const { return m_callPool.status(); }
 
     /// Freeze worker thread and sync some of the block queue.
     std::tuple<ImportRoute, bool, unsigned> syncQueue(unsigned _max = 1);
@@ -346,6 +354,10 @@ protected:
     std::condition_variable m_signalled;
     Mutex x_signalled;
 
+    /// Serialises submitTransaction() per sender (striped by address), so that concurrent
+    /// submissions from one account get consecutive nonces, while other senders go in parallel.
+    std::array<Mutex, 16> x_submitBySender;
+
     Handler<> m_tqReady;
     Handler<h256 const&> m_tqReplaced;
     Handler<> m_bqReady;
@@ -377,6 +389,8 @@ protected:
 
     Logger m_logger{createLogger(VerbosityInfo, "client")};
     Logger m_loggerDetail{createLogger(VerbosityDebug, "client")};
+
+    CallPool m_callPool;    ///< Runs calls and gas estimations. Last, so that its workers stop first.
 };
 
 }
@@ -126,6 +126,11 @@ map<h256, pair<u256, u256>> ClientBase::storageAt(Address _a, BlockNumber _block
     return blockByNumber(_block).storage(_a);
 }
 
+AccountProof ClientBase::proofAt(Address _a, u256s const& _keys, BlockNumber _block) const
+{
+    return blockByNumber(_block).proof(_a, _keys);
+}
+
 // TODO: remove try/catch, allow exceptions
 LocalisedLogEntries ClientBase::logs(unsigned _watchId) const
 {
@@ -89,6 +89,7 @@ public:
     bytes codeAt(Address _a, BlockNumber _block) const override;
     h256 codeHashAt(Address _a, BlockNumber _block) const override;
     std::map<h256, std::pair<u256, u256>> storageAt(Address _a, BlockNumber _block) const override;
+    AccountProof proofAt(Address _a, u256s const& _keys, BlockNumber _block) const override;
 
     LocalisedLogEntries logs(unsigned _watchId) const override;
     LocalisedLogEntries logs(LogFilter const& _filter) const override;
@@ -19,6 +19,7 @@
 #include "BlockChain.h"
 #include "BlockChainSync.h"
 #include "BlockQueue.h"
+#include "EthereumHostData.h"
 #include "TransactionQueue.h"
 #include <libdevcore/Common.h>
 #include <libethcore/Exceptions.h>
@@ -34,6 +35,7 @@ using namespace dev::eth;
 static unsigned const c_maxSendTransactions = 256;
 static unsigned const c_maxHeadersToSend = 1024;
 static unsigned const c_maxIncomingNewHashes = 1024;
+static unsigned const c_maxIncomingTransactionHashes = 4096;
 static int const c_backroundWorkPeriodMs = 1000;
 static int const c_minBlockBroadcastPeers = 4;
 
@@ -180,213 +182,6 @@ private:
     Logger m_logger{createLogger(VerbosityDebug, "host")};
 };
 
-class EthereumHostData: public EthereumHostDataFace
-{
-public:
-    EthereumHostData(BlockChain const& _chain, OverlayDB const& _db): m_chain(_chain), m_db(_db) {}
-
-    pair<bytes, unsigned> blockHeaders(RLP const& _blockId, unsigned _maxHeaders, u256 _skip, bool _reverse) const override
-    {
-        auto numHeadersToSend = _maxHeaders;
-
-        auto step = static_cast<unsigned>(_skip) + 1;
-        assert(step > 0 && "step must not be 0");
-
-        h256 blockHash;
-        if (_blockId.size() == 32)  // block id is a hash
-        {
-            blockHash = _blockId.toHash<h256>();
-            cnetlog << "GetBlockHeaders (block (hash): " << blockHash
-                    << ", maxHeaders: " << _maxHeaders << ", skip: " << _skip
-                    << ", reverse: " << _reverse << ")";
-
-            if (!m_chain.isKnown(blockHash))
-                blockHash = {};
-            else if (!_reverse)
-            {
-                auto n = m_chain.number(blockHash);
-                if (numHeadersToSend == 0)
-                    blockHash = {};
-                else if (n != 0 || blockHash == m_chain.genesisHash())
-                {
-                    auto top = n + uint64_t(step) * numHeadersToSend - 1;
-                    auto lastBlock = m_chain.number();
-                    if (top > lastBlock)
-                    {
-                        numHeadersToSend = (lastBlock - n) / step + 1;
-                        top = n + step * (numHeadersToSend - 1);
-                    }
-                    assert(top <= lastBlock && "invalid top block calculated");
-                    blockHash = m_chain.numberHash(static_cast<unsigned>(top)); // override start block hash with the hash of the top block we have
-                }
-                else
-                    blockHash = {};
-            }
-        }
-        else // block id is a number
-        {
-            auto n = _blockId.toInt<bigint>();
-            cnetlog << "GetBlockHeaders (" << n << " max: " << _maxHeaders << " skip: " << _skip
-                    << (_reverse ? " reverse" : "") << ")";
-
-            if (!_reverse)
-            {
-                auto lastBlock = m_chain.number();
-                if (n > lastBlock || numHeadersToSend == 0)
-                    blockHash = {};
-                else
-                {
-                    bigint top = n + uint64_t(step) * (numHeadersToSend - 1);
-                    if (top > lastBlock)
-                    {
-                        numHeadersToSend = (lastBlock - static_cast<unsigned>(n)) / step + 1;
-                        top = n + step * (numHeadersToSend - 1);
-                    }
-                    assert(top <= lastBlock && "invalid top block calculated");
-                    blockHash = m_chain.numberHash(static_cast<unsigned>(top)); // override start block hash with the hash of the top block we have
-                }
-            }
-            else if (n <= std::numeric_limits<unsigned>::max())
-                blockHash = m_chain.numberHash(static_cast<unsigned>(n));
-            else
-                blockHash = {};
-        }
-
-        auto nextHash = [this](h256 _h, unsigned _step)
-        {
-            static const unsigned c_blockNumberUsageLimit = 1000;
-
-            const auto lastBlock = m_chain.number();
-            const auto limitBlock = lastBlock > c_blockNumberUsageLimit ? lastBlock - c_blockNumberUsageLimit : 0; // find the number of the block below which we don't expect BC changes.
-
-            while (_step) // parent hash traversal
-            {
-                auto details = m_chain.details(_h);
-                if (details.number < limitBlock)
-                    break; // stop using parent hash traversal, fallback to using block numbers
-                _h = details.parent;
-                --_step;
-            }
-
-            if (_step) // still need lower block
-            {
-                auto n = m_chain.number(_h);
-                if (n >= _step)
-                    _h = m_chain.numberHash(n - _step);
-                else
-                    _h = {};
-            }
-
-
-            return _h;
-        };
-
-        bytes rlp;
-        unsigned itemCount = 0;
-        vector<h256> hashes;
-        for (unsigned i = 0; i != numHeadersToSend; ++i)
-        {
-            if (!blockHash || !m_chain.isKnown(blockHash))
-                break;
-
-            hashes.push_back(blockHash);
-            ++itemCount;
-
-            blockHash = nextHash(blockHash, step);
-        }
-
-        for (unsigned i = 0; i < hashes.size() && rlp.size() < c_maxPayload; ++i)
-            rlp += m_chain.headerData(hashes[_reverse ? i : hashes.size() - 1 - i]);
-
-        return make_pair(rlp, itemCount);
-    }
-
-    pair<bytes, unsigned> blockBodies(RLP const& _blockHashes) const override
-    {
-        unsigned const count = static_cast<unsigned>(_blockHashes.itemCount());
-
-        bytes rlp;
-        unsigned n = 0;
-        auto numBodiesToSend = std::min(count, c_maxBlocks);
-        for (unsigned i = 0; i < numBodiesToSend && rlp.size() < c_maxPayload; ++i)
-        {
-            auto h = _blockHashes[i].toHash<h256>();
-            if (m_chain.isKnown(h))
-            {
-                bytes blockBytes = m_chain.block(h);
-                RLP block{blockBytes};
-                RLPStream body;
-                body.appendList(2);
-                body.appendRaw(block[1].data());  // transactions
-                body.appendRaw(block[2].data());  // uncles
-                auto bodyBytes = body.out();
-                rlp.insert(rlp.end(), bodyBytes.begin(), bodyBytes.end());
-                ++n;
-            }
-        }
-        if (count > 20 && n == 0)
-            cnetlog << "all " << count << " unknown blocks requested; peer on different chain?";
-        else
-            cnetlog << n << " blocks known and returned; " << (numBodiesToSend - n)
-                    << " blocks unknown; " << (count > c_maxBlocks ? count - c_maxBlocks : 0)
-                    << " blocks ignored";
-
-        return make_pair(rlp, n);
-    }
-
-    strings nodeData(RLP const& _dataHashes) const override
-    {
-        unsigned const count = static_cast<unsigned>(_dataHashes.itemCount());
-
-        strings data;
-        size_t payloadSize = 0;
-        auto numItemsToSend = std::min(count, c_maxNodes);
-        for (unsigned i = 0; i < numItemsToSend && payloadSize < c_maxPayload; ++i)
-        {
-            auto h = _dataHashes[i].toHash<h256>();
-            auto node = m_db.lookup(h);
-            if (!node.empty())
-            {
-                payloadSize += node.length();
-                data.push_back(move(node));
-            }
-        }
-        cnetlog << data.size() << " nodes known and returned; " << (numItemsToSend - data.size())
-                << " unknown; " << (count > c_maxNodes ? count - c_maxNodes : 0) << " ignored";
-
-        return data;
-    }
-
-    pair<bytes, unsigned> receipts(RLP const& _blockHashes) const override
-    {
-        unsigned const count = static_cast<unsigned>(_blockHashes.itemCount());
-
-        bytes rlp;
-        unsigned n = 0;
-        auto numItemsToSend = std::min(count, c_maxReceipts);
-        for (unsigned i = 0; i < numItemsToSend && rlp.size() < c_maxPayload; ++i)
-        {
-            auto h = _blockHashes[i].toHash<h256>();
-            if (m_chain.isKnown(h))
-            {
-                auto const receipts = m_chain.receipts(h);
-                auto receiptsRlpList = receipts.rlp();
-                rlp.insert(rlp.end(), receiptsRlpList.begin(), receiptsRlpList.end());
-                ++n;
-            }
-        }
-        cnetlog << n << " receipt lists known and returned; " << (numItemsToSend - n)
-                << " unknown; " << (count > c_maxReceipts ? count - c_maxReceipts : 0)
-                << " ignored";
-
-        return make_pair(rlp, n);
-    }
-
-private:
-    BlockChain const& m_chain;
-    OverlayDB const& m_db;
-};
-
 }
 
 EthereumCapability::EthereumCapability(shared_ptr<p2p::CapabilityHostFace> _host,
@@ -464,6 +259,8 @@ void EthereumCapability::doBackgroundWork()
             m_newTransactions = false;
             maintainTransactions();
         }
+        // Retries the requests which timed out.
+        requestAnnouncedTransactions();
         if (m_newBlocks)
         {
             m_newBlocks = false;
@@ -512,26 +309,59 @@ void EthereumCapability::maintainTransactions()
 
     for (auto& peer : m_peers)
     {
-        bytes b;
-        unsigned n = 0;
-        for (auto const& i : peerTransactions[peer.first])
+        auto const& indices = peerTransactions[peer.first];
+        if (peer.second.supportsTransactionHashes())
         {
-            peer.second.markTransactionAsKnown(ts[i].sha3());
-            b += ts[i].rlp();
-            ++n;
+            // The peer fetches the transactions it doesn't have.
+            if (!indices.empty())
+            {
+                RLPStream s;
+                m_host->prep(peer.first, name(), s, NewPooledTransactionHashesPacket, indices.size());
+                for (auto const& i : indices)
+                {
+                    peer.second.markTransactionAsKnown(ts[i].sha3());
+                    s << ts[i].sha3();
+                }
+                m_host->sealAndSend(peer.first, s);
+                LOG(m_logger) << "Announced " << indices.size() << " transactions to " << peer.first;
+            }
         }
-
-        if (n || peer.second.isWaitingForTransactions())
+        else
         {
-            RLPStream ts;
-            m_host->prep(peer.first, name(), ts, TransactionsPacket, n).appendRaw(b, n);
-            m_host->sealAndSend(peer.first, ts);
-            LOG(m_logger) << "Sent " << n << " transactions to " << peer.first;
+            bytes b;
+            unsigned n = 0;
+            for (auto const& i : indices)
+            {
+                peer.second.markTransactionAsKnown(ts[i].sha3());
+                b += ts[i].rlp();
+                ++n;
+            }
+
+            if (n || peer.second.isWaitingForTransactions())
+            {
+                RLPStream ts;
+                m_host->prep(peer.first, name(), ts, TransactionsPacket, n).appendRaw(b, n);
+                m_host->sealAndSend(peer.first, ts);
+                LOG(m_logger) << "Sent " << n << " transactions to " << peer.first;
+            }
         }
         peer.second.setWaitingForTransactions(false);
     }
 }
 
+void EthereumCapability::requestAnnouncedTransactions()
+{
+    for (auto const& request : m_transactionFetcher.takeRequests())
+    {
+        auto peer = m_peers.find(request.first);
+        if (peer == m_peers.end())
+            continue;
+        LOG(m_logger) << "Requesting " << request.second.size() << " transactions from "
+                      << request.first;
+        peer->second.requestPooledTransactions(request.second);
+    }
+}
+
 vector<NodeID> EthereumCapability::selectPeers(
     std::function<bool(EthereumPeer const&)> const& _predicate) const
 {
@@ -688,6 +518,7 @@ void EthereumCapability::onDisconnect(NodeID const& _peerID)
     m_peerObserver->onPeerAborting();
 
     m_peers.erase(_peerID);
+    m_transactionFetcher.notePeerGone(_peerID);
 }
 
 bool EthereumCapability::interpretCapabilityPacket(
@@ -696,6 +527,15 @@ bool EthereumCapability::interpretCapabilityPacket(
     auto& peer = m_peers[_peerID];
     peer.setLastAsk(std::chrono::system_clock::to_time_t(chrono::system_clock::now()));
 
+    bool const isTransactionHashesPacket = _id == NewPooledTransactionHashesPacket ||
+                                           _id == GetPooledTransactionsPacket ||
+                                           _id == PooledTransactionsPacket;
+    if (isTransactionHashesPacket && !peer.supportsTransactionHashes())
+    {
+        disablePeer(_peerID, "Transaction hash packet before eth/65");
+        return true;
+    }
+
     try
     {
         switch (_id)
@@ -722,6 +562,71 @@ bool EthereumCapability::interpretCapabilityPacket(
             m_peerObserver->onPeerTransactions(_peerID, _r);
             break;
         }
+        case NewPooledTransactionHashesPacket:
+        {
+            unsigned const itemCount = _r.itemCount();
+            if (itemCount > c_maxIncomingTransactionHashes)
+            {
+                disablePeer(_peerID, "Too many transaction hashes");
+                break;
+            }
+
+            h256s unknown;
+            for (auto const& item : _r)
+            {
+                h256 const hash = item.toHash<h256>(RLP::VeryStrict);
+                peer.markTransactionAsKnown(hash);
+                if (!m_tq.isKnown(hash))
+                    unknown.push_back(hash);
+            }
+            LOG(m_logger) << "Transaction hashes (" << dec << itemCount << " entries, "
+                          << unknown.size() << " unknown)";
+            m_transactionFetcher.noteAnnounced(_peerID, unknown);
+            requestAnnouncedTransactions();
+            break;
+        }
+        case GetPooledTransactionsPacket:
+        {
+            unsigned const itemCount = _r.itemCount();
+            if (itemCount > c_maxIncomingTransactionHashes)
+            {
+                disablePeer(_peerID, "Too many transactions requested");
+                break;
+            }
+
+            // Transactions we no longer have are left out of the reply.
+            bytes rlp;
+            unsigned n = 0;
+            for (auto const& item : _r)
+            {
+                if (rlp.size() >= c_maxPayload)
+                    break;
+                bytes const transaction =
+                    m_tq.currentTransactionRLP(item.toHash<h256>(RLP::VeryStrict));
+                if (!transaction.empty())
+                {
+                    rlp += transaction;
+                    ++n;
+                }
+            }
+            m_host->updateRating(_peerID, 0);
+            RLPStream s;
+            m_host->prep(_peerID, name(), s, PooledTransactionsPacket, n).appendRaw(rlp, n);
+            m_host->sealAndSend(_peerID, s);
+            break;
+        }
+        case PooledTransactionsPacket:
+        {
+            h256s hashes;
+            for (auto const& item : _r)
+                hashes.push_back(sha3(item.data()));
+            if (!m_transactionFetcher.noteDelivered(_peerID, hashes))
+                LOG(m_loggerImpolite) << "Peer giving us transactions we didn't ask for.";
+            m_peerObserver->onPeerTransactions(_peerID, _r);
+            // Asks other peers for what this one didn't have.
+            requestAnnouncedTransactions();
+            break;
+        }
         case GetBlockHeadersPacket:
         {
             /// Packet layout:
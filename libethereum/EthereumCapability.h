@@ -19,6 +19,7 @@
 
 #include "CommonNet.h"
 #include "EthereumPeer.h"
+#include "TransactionFetcher.h"
 #include <libdevcore/Guards.h>
 #include <libdevcore/OverlayDB.h>
 #include <libethcore/BlockHeader.h>
@@ -154,6 +155,8 @@ private:
     void doBackgroundWork();
 
     void maintainTransactions();
+    /// Requests the announced transactions we don't have, each from one of the peers announcing it.
+    void requestAnnouncedTransactions();
     void maintainBlocks(h256 const& _currentBlock);
     void onTransactionImported(ImportResult _ir, h256 const& _h, h512 const& _nodeId);
 
@@ -180,6 +183,7 @@ private:
 
     h256 m_latestBlockSent;
     h256Hash m_transactionsSent;
+    TransactionFetcher m_transactionFetcher;
 
     std::atomic<bool> m_newTransactions = {false};
     std::atomic<bool> m_newBlocks = {false};
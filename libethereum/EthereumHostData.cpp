@@ -0,0 +1,230 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "EthereumHostData.h"
+#include "BlockChain.h"
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+pair<bytes, unsigned> EthereumHostData::blockHeaders(
+    RLP const& _blockId, unsigned _maxHeaders, u256 _skip, bool _reverse) const
+{
+    auto numHeadersToSend = _maxHeaders;
+
+    auto step = static_cast<unsigned>(_skip) + 1;
+    assert(step > 0 && "step must not be 0");
+
+    h256 blockHash;
+    if (_blockId.size() == 32)  // block id is a hash
+    {
+        blockHash = _blockId.toHash<h256>();
+        cnetlog << "GetBlockHeaders (block (hash): " << blockHash
+                << ", maxHeaders: " << _maxHeaders << ", skip: " << _skip
+                << ", reverse: " << _reverse << ")";
+
+        if (!m_chain.isKnown(blockHash))
+            blockHash = {};
+        else if (!_reverse)
+        {
+            auto n = m_chain.number(blockHash);
+            if (numHeadersToSend == 0)
+                blockHash = {};
+            else if (n != 0 || blockHash == m_chain.genesisHash())
+            {
+                auto top = n + uint64_t(step) * numHeadersToSend - 1;
+                auto lastBlock = m_chain.number();
+                if (top > lastBlock)
+                {
+                    numHeadersToSend = (lastBlock - n) / step + 1;
+                    top = n + step * (numHeadersToSend - 1);
+                }
+                assert(top <= lastBlock && "invalid top block calculated");
+                blockHash = m_chain.numberHash(static_cast<unsigned>(top)); // override start block hash with the hash of the top block we have
+            }
+            else
+                blockHash = {};
+        }
+    }
+    else // block id is a number
+    {
+        auto n = _blockId.toInt<bigint>();
+        cnetlog << "GetBlockHeaders (" << n << " max: " << _maxHeaders << " skip: " << _skip
+                << (_reverse ? " reverse" : "") << ")";
+
+        if (!_reverse)
+        {
+            auto lastBlock = m_chain.number();
+            if (n > lastBlock || numHeadersToSend == 0)
+                blockHash = {};
+            else
+            {
+                bigint top = n + uint64_t(step) * (numHeadersToSend - 1);
+                if (top > lastBlock)
+                {
+                    numHeadersToSend = (lastBlock - static_cast<unsigned>(n)) / step + 1;
+                    top = n + step * (numHeadersToSend - 1);
+                }
+                assert(top <= lastBlock && "invalid top block calculated");
+                blockHash = m_chain.numberHash(static_cast<unsigned>(top)); // override start block hash with the hash of the top block we have
+            }
+        }
+        else if (n <= std::numeric_limits<unsigned>::max())
+            blockHash = m_chain.numberHash(static_cast<unsigned>(n));
+        else
+            blockHash = {};
+    }
+
+    auto nextHash = [this](h256 _h, unsigned _step)
+    {
+        static const unsigned c_blockNumberUsageLimit = 1000;
+
+        const auto lastBlock = m_chain.number();
+        const auto limitBlock = lastBlock > c_blockNumberUsageLimit ? lastBlock - c_blockNumberUsageLimit : 0; // find the number of the block below which we don't expect BC changes.
+
+        while (_step) // parent hash traversal
+        {
+            auto details = m_chain.details(_h);
+            if (details.number < limitBlock)
+                break; // stop using parent hash traversal, fallback to using block numbers
+            _h = details.parent;
+            --_step;
+        }
+
+        if (_step) // still need lower block
+        {
+            auto n = m_chain.number(_h);
+            if (n >= _step)
+                _h = m_chain.numberHash(n - _step);
+            else
+                _h = {};
+        }
+
+
+        return _h;
+    };
+
+    bytes rlp;
+    unsigned itemCount = 0;
+    vector<h256> hashes;
+    for (unsigned i = 0; i != numHeadersToSend; ++i)
+    {
+        if (!blockHash || !m_chain.isKnown(blockHash))
+            break;
+
+        hashes.push_back(blockHash);
+        ++itemCount;
+
+        blockHash = nextHash(blockHash, step);
+    }
+
+    for (unsigned i = 0; i < hashes.size() && rlp.size() < m_maxPayload; ++i)
+        rlp += m_chain.headerData(hashes[_reverse ? i : hashes.size() - 1 - i]);
+
+    return make_pair(rlp, itemCount);
+}
+
+pair<bytes, unsigned> EthereumHostData::blockBodies(RLP const& _blockHashes) const
+{
+    unsigned const count = static_cast<unsigned>(_blockHashes.itemCount());
+
+    bytes rlp;
+    unsigned n = 0;
+    auto numBodiesToSend = std::min(count, c_maxBlocks);
+    for (unsigned i = 0; i < numBodiesToSend; ++i)
+    {
+        auto h = _blockHashes[i].toHash<h256>();
+        bytes const* body = m_servedBodies.find(h);
+        if (!body && m_chain.isKnown(h))
+        {
+            // Slice the transactions and uncles out of the stored block, no decoding.
+            bytes const blockBytes = m_chain.block(h);
+            RLP const block{blockBytes};
+            RLPStream bodyStream(2);
+            bodyStream.appendRaw(block[1].data()).appendRaw(block[2].data());
+            body = &m_servedBodies.insert(h, bodyStream.invalidate());
+        }
+        if (body)
+        {
+            if (!appendWithinBudget(rlp, *body, m_maxPayload))
+                break;
+            ++n;
+        }
+    }
+    if (count > 20 && n == 0)
+        cnetlog << "all " << count << " unknown blocks requested; peer on different chain?";
+    else
+        cnetlog << n << " blocks known and returned; " << (numBodiesToSend - n)
+                << " blocks unknown or over the size limit; "
+                << (count > c_maxBlocks ? count - c_maxBlocks : 0) << " blocks ignored";
+
+    return make_pair(rlp, n);
+}
+
+strings EthereumHostData::nodeData(RLP const& _dataHashes) const
+{
+    unsigned const count = static_cast<unsigned>(_dataHashes.itemCount());
+
+    strings data;
+    size_t payloadSize = 0;
+    auto numItemsToSend = std::min(count, c_maxNodes);
+    for (unsigned i = 0; i < numItemsToSend; ++i)
+    {
+        auto h = _dataHashes[i].toHash<h256>();
+        auto node = m_db.lookup(h);
+        if (!node.empty())
+        {
+            if (!data.empty() && payloadSize + node.size() > m_maxPayload)
+                break;
+            payloadSize += node.length();
+            data.push_back(move(node));
+        }
+    }
+    cnetlog << data.size() << " nodes known and returned; " << (numItemsToSend - data.size())
+            << " unknown or over the size limit; "
+            << (count > c_maxNodes ? count - c_maxNodes : 0) << " ignored";
+
+    return data;
+}
+
+pair<bytes, unsigned> EthereumHostData::receipts(RLP const& _blockHashes) const
+{
+    unsigned const count = static_cast<unsigned>(_blockHashes.itemCount());
+
+    bytes rlp;
+    unsigned n = 0;
+    auto numItemsToSend = std::min(count, c_maxReceipts);
+    for (unsigned i = 0; i < numItemsToSend; ++i)
+    {
+        auto h = _blockHashes[i].toHash<h256>();
+        bytes const* receipts = m_servedReceipts.find(h);
+        if (!receipts && m_chain.isKnown(h))
+        {
+            // Served as stored, without decoding and re-encoding each receipt.
+            bytes receiptsRlpList = m_chain.receiptsData(h);
+            if (!receiptsRlpList.empty())
+                receipts = &m_servedReceipts.insert(h, move(receiptsRlpList));
+        }
+        if (receipts)
+        {
+            if (!appendWithinBudget(rlp, *receipts, m_maxPayload))
+                break;
+            ++n;
+        }
+    }
+    cnetlog << n << " receipt lists known and returned; " << (numItemsToSend - n)
+            << " unknown or over the size limit; "
+            << (count > c_maxReceipts ? count - c_maxReceipts : 0) << " ignored";
+
+    return make_pair(rlp, n);
+}
+
+bool EthereumHostData::appendWithinBudget(bytes& _rlp, bytes const& _item, size_t _maxPayload)
+{
+    if (!_rlp.empty() && _rlp.size() + _item.size() > _maxPayload)
+        return false;
+    _rlp.insert(_rlp.end(), _item.begin(), _item.end());
+    return true;
+}
@@ -0,0 +1,101 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Data served to the peers of the eth capability.
+#pragma once
+
+#include "EthereumCapability.h"
+
+#include <list>
+#include <unordered_map>
+
+namespace dev
+{
+class OverlayDB;
+
+namespace eth
+{
+class BlockChain;
+
+/// Bytes of each served items cache.
+static size_t const c_servedItemsCacheSize = 8 * 1024 * 1024;
+
+/// Least recently used cache of encoded items served to the peers, bounded in bytes.
+/// An item larger than the bound is still kept, alone, until the next insert().
+/// @warning Not thread-safe; used only on the network thread.
+class ServedItemsCache
+{
+public:
+    explicit ServedItemsCache(size_t _maxBytes): m_maxBytes(_maxBytes) {}
+
+    /// @returns the cached item or nullptr. The pointer is valid until the next insert().
+    bytes const* find(h256 const& _hash)
+    {
+        auto it = m_index.find(_hash);
+        if (it == m_index.end())
+            return nullptr;
+        m_items.splice(m_items.begin(), m_items, it->second);
+        return &it->second->second;
+    }
+
+    bytes const& insert(h256 const& _hash, bytes _item)
+    {
+        m_bytes += _item.size();
+        m_items.emplace_front(_hash, std::move(_item));
+        m_index[_hash] = m_items.begin();
+        while (m_bytes > m_maxBytes && m_items.size() > 1)
+        {
+            m_bytes -= m_items.back().second.size();
+            m_index.erase(m_items.back().first);
+            m_items.pop_back();
+        }
+        return m_items.front().second;
+    }
+
+private:
+    size_t const m_maxBytes;
+    size_t m_bytes = 0;
+    std::list<std::pair<h256, bytes>> m_items;  ///< Most recently used first.
+    std::unordered_map<h256, std::list<std::pair<h256, bytes>>::iterator> m_index;
+};
+
+/// Serves the block headers, bodies, receipts and state nodes requested by the peers from the
+/// chain and the state database. Replies stop before growing over @a _maxPayload, but always
+/// hold at least one item.
+class EthereumHostData: public EthereumHostDataFace
+{
+public:
+    EthereumHostData(BlockChain const& _chain, OverlayDB const& _db,
+        size_t _maxPayload = c_maxPayload, size_t _servedItemsCacheSize = c_servedItemsCacheSize)
+      : m_chain(_chain),
+        m_db(_db),
+        m_maxPayload(_maxPayload),
+        m_servedBodies(_servedItemsCacheSize),
+        m_servedReceipts(_servedItemsCacheSize)
+    {}
+
+    std::pair<bytes, unsigned> blockHeaders(
+        RLP const& _blockId, unsigned _maxHeaders, u256 _skip, bool _reverse) const override;
+    std::pair<bytes, unsigned> blockBodies(RLP const& _blockHashes) const override;
+    strings nodeData(RLP const& _dataHashes) const override;
+    std::pair<bytes, unsigned> receipts(RLP const& _blockHashes) const override;
+
+private:
+    /// Appends @a _item to the reply @a _rlp unless it would grow over @a _maxPayload. The first
+    /// item is always appended, so that a large item can be served at all.
+    static bool appendWithinBudget(bytes& _rlp, bytes const& _item, size_t _maxPayload);
+
+    BlockChain const& m_chain;
+    OverlayDB const& m_db;
+    size_t const m_maxPayload;
+
+    /// Block bodies and receipts served recently. Peers syncing from us ask for the same recent
+    /// blocks, so these spare the database lookups and the re-encoding.
+    mutable ServedItemsCache m_servedBodies;
+    mutable ServedItemsCache m_servedReceipts;
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -64,13 +64,12 @@ void EthereumPeer::setStatus(unsigned _protocolVersion, u256 const& _networkId,
 }
 
 
-std::string EthereumPeer::validate(
-    h256 const& _hostGenesisHash, unsigned _hostProtocolVersion, u256 const& _hostNetworkId) const
+std::string EthereumPeer::validate(h256 const& _hostGenesisHash, u256 const& _hostNetworkId) const
 {
     std::string error;
     if (m_genesisHash != _hostGenesisHash)
         error = "Invalid genesis hash.";
-    else if (m_protocolVersion != _hostProtocolVersion)
+    else if (m_protocolVersion != m_capabilityVersion)
         error = "Invalid protocol version.";
     else if (m_networkId != _hostNetworkId)
         error = "Invalid network identifier.";
@@ -88,7 +87,7 @@ void EthereumPeer::requestStatus(
     m_requireTransactions = true;
     RLPStream s;
     m_host->prep(m_id, c_ethCapability, s, StatusPacket, 5)
-        << c_protocolVersion << _hostNetworkId << _chainTotalDifficulty << _chainCurrentHash
+        << m_capabilityVersion << _hostNetworkId << _chainTotalDifficulty << _chainCurrentHash
         << _chainGenesisHash;
     m_host->sealAndSend(m_id, s);
 }
@@ -143,6 +142,16 @@ void EthereumPeer::requestReceipts(h256s const& _blocks)
     requestByHashes(_blocks, Asking::Receipts, GetReceiptsPacket);
 }
 
+void EthereumPeer::requestPooledTransactions(h256s const& _hashes)
+{
+    // Not a sync request, so it doesn't change what we're asking the peer for.
+    RLPStream s;
+    m_host->prep(m_id, c_ethCapability, s, GetPooledTransactionsPacket, _hashes.size());
+    for (auto const& h : _hashes)
+        s << h;
+    m_host->sealAndSend(m_id, s);
+}
+
 void EthereumPeer::requestByHashes(
     h256s const& _hashes, Asking _asking, SubprotocolPacketType _packetType)
 {
@@ -18,6 +18,8 @@
 #pragma once
 
 #include "CommonNet.h"
+#include <libdevcore/RotatingBloomFilter.h>
+#include <libethcore/Common.h>
 
 namespace dev
 {
@@ -28,23 +30,44 @@ class CapabilityHostFace;
 
 namespace eth
 {
+/// Number of blocks and transactions remembered at least as known by each peer. Each of the two
+/// generations of a filter takes about 2.4 bytes per hash of capacity, so ~4.8 bytes in all:
+/// ~78 KB per peer for the transactions and ~5 KB for the blocks, rather than the ~100 bytes of a
+/// hash set entry.
+size_t const c_knownBlocksCapacity = 1024;
+size_t const c_knownTransactionsCapacity = 16384;
+/// Chance, for each generation, to take a block or transaction as known by the peer when it isn't,
+/// and not send it. A lookup checks both generations, so the chance is up to twice this.
+double const c_knownFalsePositiveRate = 0.0001;
+
 class EthereumPeer
 {
 public:
     EthereumPeer() = default;
     EthereumPeer(std::shared_ptr<p2p::CapabilityHostFace> _host, NodeID const& _peerID,
-        u256 const& /*_capabilityVersion*/)
-      : m_host(std::move(_host)), m_id(_peerID)
+        u256 const& _capabilityVersion)
+      : m_host(std::move(_host)),
+        m_id(_peerID),
+        m_capabilityVersion(static_cast<unsigned>(_capabilityVersion))
     {}
 
     void setStatus(unsigned _protocolVersion, u256 const& _networkId, u256 const& _totalDifficulty,
         h256 const& _latestHash, h256 const& _genesisHash);
 
-    std::string validate(h256 const& _hostGenesisHash, unsigned _hostProtocolVersion,
-        u256 const& _hostNetworkId) const;
+    /// Checks the status of the peer, whose protocol version must be the one of the session.
+    std::string validate(h256 const& _hostGenesisHash, u256 const& _hostNetworkId) const;
 
     NodeID id() const { return m_id; }
 
+    /// @returns the protocol version agreed on for the session.
+    unsigned capabilityVersion() const { return m_capabilityVersion; }
+
+    /// @returns whether the peer announces and fetches transactions by hash.
+    bool supportsTransactionHashes() const
+    {
+        return m_capabilityVersion >= c_transactionHashesVersion;
+    }
+
     u256 totalDifficulty() const { return m_totalDifficulty; }
 
     time_t lastAsk() const { return m_lastAsk; }
@@ -60,10 +83,11 @@ public:
     bool isWaitingForTransactions() const { return m_requireTransactions; }
     void setWaitingForTransactions(bool _value) { m_requireTransactions = _value; }
 
-    bool isTransactionKnown(h256 const& _hash) const { return m_knownTransactions.count(_hash); }
+    bool isTransactionKnown(h256 const& _hash) const { return m_knownTransactions.contains(_hash); }
+    /// Remembers the @a _hash among the most recent transactions the peer knows.
     void markTransactionAsKnown(h256 const& _hash) { m_knownTransactions.insert(_hash); }
 
-    bool isBlockKnown(h256 const& _hash) const { return m_knownBlocks.count(_hash); }
+    bool isBlockKnown(h256 const& _hash) const { return m_knownBlocks.contains(_hash); }
     void markBlockAsKnown(h256 const& _hash) { m_knownBlocks.insert(_hash); }
     void clearKnownBlocks() { m_knownBlocks.clear(); }
 
@@ -87,6 +111,9 @@ public:
     /// Request receipts for specified blocks from peer.
     void requestReceipts(h256s const& _blocks);
 
+    /// Request the transactions with the given hashes which the peer announced.
+    void requestPooledTransactions(h256s const& _hashes);
+
 private:
     // Request of type _packetType with _hashes as input parameters
     void requestByHashes(h256s const& _hashes, Asking _asking, SubprotocolPacketType _packetType);
@@ -95,6 +122,9 @@ private:
 
     NodeID const m_id;
 
+    /// Protocol version agreed on for the session.
+    unsigned m_capabilityVersion = c_protocolVersion;
+
     /// What, if anything, we last asked the other peer for.
     Asking m_asking = Asking::Nothing;
     /// When we asked for it. Allows a time out.
@@ -113,8 +143,9 @@ private:
     bool m_requireTransactions = false;
 
     /// Blocks that the peer already knows about (that don't need to be sent to them).
-    h256Hash m_knownBlocks;
-    h256Hash m_knownTransactions;     ///< Transactions that the peer already knows of.
+    RotatingBloomFilter m_knownBlocks{c_knownBlocksCapacity, c_knownFalsePositiveRate};
+    /// Transactions that the peer already knows of.
+    RotatingBloomFilter m_knownTransactions{c_knownTransactionsCapacity, c_knownFalsePositiveRate};
     unsigned m_unknownNewBlocks = 0;  ///< Number of unknown NewBlocks received from this peer
     unsigned m_lastAskedHeaders = 0;  ///< Number of hashes asked
 
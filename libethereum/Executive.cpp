@@ -181,7 +181,8 @@ string StandardTrace::multilineTrace() const
 
 Executive::Executive(Block& _s, BlockChain const& _bc, unsigned _level):
     m_s(_s.mutableState()),
-    m_envInfo(_s.info(), _bc.lastBlockHashes(), 0),
+    m_ownEnvInfo(new EnvInfo(_s.info(), _bc.lastBlockHashes(), 0)),
+    m_envInfo(*m_ownEnvInfo),
     m_depth(_level),
     m_sealEngine(*_bc.sealEngine())
 {
@@ -189,7 +190,8 @@ Executive::Executive(Block& _s, BlockChain const& _bc, unsigned _level):
 
 Executive::Executive(Block& _s, LastBlockHashesFace const& _lh, unsigned _level):
     m_s(_s.mutableState()),
-    m_envInfo(_s.info(), _lh, 0),
+    m_ownEnvInfo(new EnvInfo(_s.info(), _lh, 0)),
+    m_envInfo(*m_ownEnvInfo),
     m_depth(_level),
     m_sealEngine(*_s.sealEngine())
 {
@@ -197,7 +199,9 @@ Executive::Executive(Block& _s, LastBlockHashesFace const& _lh, unsigned _level)
 
 Executive::Executive(State& io_s, Block const& _block, unsigned _txIndex, BlockChain const& _bc, unsigned _level):
     m_s(createIntermediateState(io_s, _block, _txIndex, _bc)),
-    m_envInfo(_block.info(), _bc.lastBlockHashes(), _txIndex ? _block.receipt(_txIndex - 1).cumulativeGasUsed() : 0),
+    m_ownEnvInfo(new EnvInfo(_block.info(), _bc.lastBlockHashes(),
+        _txIndex ? _block.receipt(_txIndex - 1).cumulativeGasUsed() : 0)),
+    m_envInfo(*m_ownEnvInfo),
     m_depth(_level),
     m_sealEngine(*_bc.sealEngine())
 {
@@ -305,6 +309,7 @@ bool Executive::call(CallParameters const& _p, u256 const& _gasPrice, Address co
 
     if (m_sealEngine.isPrecompiled(_p.codeAddress, m_envInfo.number()))
     {
+        m_s.notePrecompileCall(_p.codeAddress);
         bigint g = m_sealEngine.costOfPrecompiled(_p.codeAddress, _p.data, m_envInfo.number());
         if (_p.gas < g)
         {
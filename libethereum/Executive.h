@@ -104,7 +104,9 @@ class Executive
 {
 public:
     /// Simple constructor; executive will operate on given state, with the given environment info.
+    /// @a _envInfo is referenced, not copied, and must outlive the executive.
     Executive(State& _s, EnvInfo const& _envInfo, SealEngineFace const& _sealEngine, unsigned _level = 0): m_s(_s), m_envInfo(_envInfo), m_depth(_level), m_sealEngine(_sealEngine) {}
+    Executive(State& _s, EnvInfo&& _envInfo, SealEngineFace const& _sealEngine, unsigned _level = 0) = delete;
 
     /** Easiest constructor.
      * Creates executive to operate on the state of end of the given block, populating environment
@@ -191,8 +193,8 @@ private:
     bool executeCreate(Address const& _txSender, u256 const& _endowment, u256 const& _gasPrice, u256 const& _gas, bytesConstRef _code, Address const& _originAddress);
 
     State& m_s;							///< The state to which this operation/transaction is applied.
-    // TODO: consider changign to EnvInfo const& to avoid LastHashes copy at every CALL/CREATE
-    EnvInfo m_envInfo;					///< Information on the runtime environment.
+    std::unique_ptr<EnvInfo const> m_ownEnvInfo;	///< Environment built by the Block constructors; null if given by the caller.
+    EnvInfo const& m_envInfo;			///< Information on the runtime environment, shared by nested CALL/CREATE executives.
     std::shared_ptr<ExtVM> m_ext;		///< The VM externality object for the VM execution or null if no VM is required. shared_ptr used only to allow ExtVM forward reference. This field does *NOT* survive this object.
     owning_bytes_ref m_output;			///< Execution output.
     ExecutionResult* m_res = nullptr;	///< Optional storage for execution results.
@@ -122,6 +122,12 @@ evmc_status_code transactionExceptionToEvmcStatusCode(TransactionException ex) n
 
 } // anonymous namespace
 
+h256s const& EnvInfo::precedingHashes() const
+{
+    if (m_precedingHashes.empty())
+        m_precedingHashes = m_lastHashes.precedingHashes(m_headerInfo.parentHash());
+    return m_precedingHashes;
+}
 
 CallResult ExtVM::call(CallParameters& _p)
 {
@@ -192,8 +198,7 @@ h256 ExtVM::blockHash(u256 _number)
 
     if (currentNumber < m_sealEngine.chainParams().experimentalForkBlock + 256)
     {
-        h256 const parentHash = envInfo().header().parentHash();
-        h256s const lastHashes = envInfo().lastHashes().precedingHashes(parentHash);
+        h256s const& lastHashes = envInfo().precedingHashes();
 
         assert(lastHashes.size() > (unsigned)(currentNumber - 1 - _number));
         return lastHashes[(unsigned)(currentNumber - 1 - _number)];
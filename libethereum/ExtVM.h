@@ -57,6 +57,12 @@ public:
     /// Read storage location.
     u256 store(u256 _n) final { return m_s.storage(myAddress, _n); }
 
+    /// Read storage locations, looking the account up once.
+    void storeBatch(u256 const* _keys, u256* o_values, size_t _count) final
+    {
+        m_s.storage(myAddress, _keys, o_values, _count);
+    }
+
     /// Write a value in storage.
     void setStore(u256 _n, u256 _v) final;
 
@@ -47,9 +47,14 @@ public:
 		return it != m_stages.end() ? it->second : 0;
 	}
 
+	/// @returns the duration of every finished stage, and of the whole import as "total" once
+	/// onFinished() was called.
+	std::unordered_map<std::string, double> const& stages() const { return m_stages; }
+
 	void onFinished(std::unordered_map<std::string, std::string> const& _additionalValues)
 	{
 		double const totalElapsed = m_totalTimer.elapsed();
+		m_stages["total"] = totalElapsed;
 		if (totalElapsed > 0.5)
 		{
             cdebug << "SLOW IMPORT: { " << constructReport(totalElapsed, _additionalValues) << " }";
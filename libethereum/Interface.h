@@ -30,6 +30,7 @@
 #include "LogFilter.h"
 #include "Transaction.h"
 #include "BlockDetails.h"
+#include "AccountProof.h"
 
 namespace dev
 {
@@ -121,6 +122,8 @@ public:
 	virtual bytes codeAt(Address _a, BlockNumber _block) const = 0;
 	virtual h256 codeHashAt(Address _a, BlockNumber _block) const = 0;
 	virtual std::map<h256, std::pair<u256, u256>> storageAt(Address _a, BlockNumber _block) const = 0;
+	/// @returns the Merkle proof of the account @a _a and of its storage slots @a _keys.
+	virtual AccountProof proofAt(Address _a, u256s const& _keys, BlockNumber _block) const = 0;
 
 	// [LOGS API]
 	
@@ -37,6 +37,18 @@ using namespace dev;
 using namespace dev::eth;
 namespace fs = boost::filesystem;
 
+namespace
+{
+/// Initial number of slots of the changelog index, enough for most transactions.
+size_t const c_changeLogIndexSize = 256;
+
+size_t changeHash(Change::Kind _kind, Address const& _address, u256 const& _key)
+{
+    return (std::hash<Address>{}(_address) ^ static_cast<size_t>(_key) * size_t(0x9e3779b97f4a7c15)) +
+           _kind;
+}
+}  // namespace
+
 State::State(u256 const& _accountStartNonce, OverlayDB const& _db, BaseState _bs):
     m_db(_db),
     m_state(&m_db),
@@ -141,6 +153,7 @@ State& State::operator=(State const& _s)
     m_nonExistingAccountsCache = _s.m_nonExistingAccountsCache;
     m_touched = _s.m_touched;
     m_accountStartNonce = _s.m_accountStartNonce;
+    m_changeLogBarrier = m_changeLog.size();
     return *this;
 }
 
@@ -159,6 +172,7 @@ Account* State::account(Address const& _addr)
         return nullptr;
 
     // Populate basic info.
+    ++m_executionCounters.dbMisses;
     string stateBack = m_state.at(_addr);
     if (stateBack.empty())
     {
@@ -201,10 +215,37 @@ void State::commit(CommitBehaviour _commitBehaviour)
 {
     if (_commitBehaviour == CommitBehaviour::RemoveEmptyAccounts)
         removeEmptyAccounts();
+    if (m_stateDiff)
+        noteStateDiffBefore();
     m_touched += dev::eth::commit(m_cache, m_state);
+    if (m_stateDiff)
+        noteStateDiffAfter();
     m_changeLog.clear();
-    m_cache.clear();
+    fill(m_changeLogIndex.begin(), m_changeLogIndex.end(), 0);
+    m_changeLogIndexUsed = 0;
+    m_changeLogBarrier = 0;
+
+    // Keep the committed accounts cached, with their code and the storage read so far, so that
+    // the next transactions of the block don't have to load the sender and coinbase again.
     m_unchangedCacheEntries.clear();
+    for (auto it = m_cache.begin(); it != m_cache.end();)
+    {
+        Account& account = it->second;
+        if (account.isDirty())
+        {
+            if (!account.isAlive())
+            {
+                it = m_cache.erase(it);
+                continue;
+            }
+            account.noteCommitted(account.storageOverlay().empty() ?
+                                      account.baseRoot() :
+                                      RLP(m_state.at(it->first))[2].toHash<h256>());
+        }
+        m_unchangedCacheEntries.push_back(it->first);
+        ++it;
+    }
+    clearCacheIfTooLarge();
 }
 
 unordered_map<Address, u256> State::addresses() const
@@ -286,15 +327,98 @@ void State::setRoot(h256 const& _r)
     m_nonExistingAccountsCache.clear();
 //  m_touched.clear();
     m_state.setRoot(_r);
+    if (m_stateDiff)
+        startStateDiff();
+}
+
+void State::noteStateDiffBefore()
+{
+    for (auto const& i : m_cache)
+        if (i.second.isDirty() && !m_stateDiff->accounts.count(i.first))
+            m_stateDiff->accounts[i.first].before = AccountSnapshot(RLP(m_state.at(i.first)));
+}
+
+void State::noteStateDiffAfter()
+{
+    for (auto const& i : m_cache)
+    {
+        if (!i.second.isDirty())
+            continue;
+
+        AccountDiff& diff = m_stateDiff->accounts[i.first];
+        diff.after = AccountSnapshot(RLP(m_state.at(i.first)));
+        for (auto const& slot : i.second.storageOverlay())
+        {
+            auto it = diff.storage.find(slot.first);
+            if (it == diff.storage.end())
+            {
+                // First write to this slot in the block - the original value lives in the storage
+                // trie the account had before the block.
+                u256 original = 0;
+                if (diff.before.exists)
+                {
+                    SecureTrieDB<h256, OverlayDB> const storageDB(&m_db, diff.before.storageRoot);
+                    std::string const payload = storageDB.at(slot.first);
+                    if (!payload.empty())
+                        original = RLP(payload).toInt<u256>();
+                }
+                it = diff.storage.emplace(slot.first, make_pair(original, u256())).first;
+            }
+            it->second.second = slot.second;
+        }
+        if (!diff.after.exists)
+            for (auto& slot : diff.storage)
+                slot.second.second = 0;
+    }
+    m_stateDiff->rootAfter = rootHash();
+}
+
+StateDiff State::takeStateDiff()
+{
+    if (!m_stateDiff)
+        return NullStateDiff;
+
+    StateDiff ret = std::move(*m_stateDiff);
+    m_stateDiff.reset();
+    return ret;
+}
+
+void State::applyStateDiff(StateDiff const& _diff, StateDiffDirection _direction)
+{
+    bool const revert = _direction == StateDiffDirection::Revert;
+    if (rootHash() != (revert ? _diff.rootAfter : _diff.rootBefore))
+        BOOST_THROW_EXCEPTION(InvalidStateDiffRoot() << errinfo_hash256(rootHash()));
+
+    // Any uncommitted changes would be lost on setRoot() anyway.
+    m_cache.clear();
+    m_unchangedCacheEntries.clear();
+    m_nonExistingAccountsCache.clear();
+
+    for (auto const& a : _diff.accounts)
+    {
+        AccountSnapshot const& target = revert ? a.second.before : a.second.after;
+        if (target.exists)
+        {
+            bytes const rlp = target.trieRLP();
+            m_state.insert(a.first, &rlp);
+        }
+        else
+            m_state.remove(a.first);
+    }
+
+    if (rootHash() != (revert ? _diff.rootBefore : _diff.rootAfter))
+        BOOST_THROW_EXCEPTION(InvalidStateDiffRoot() << errinfo_hash256(rootHash()));
 }
 
 bool State::addressInUse(Address const& _id) const
 {
+    ++m_executionCounters.stateReads;
     return !!account(_id);
 }
 
 bool State::accountNonemptyAndExisting(Address const& _address) const
 {
+    ++m_executionCounters.stateReads;
     if (Account const* a = account(_address))
         return !a->isEmpty();
     else
@@ -303,6 +427,7 @@ bool State::accountNonemptyAndExisting(Address const& _address) const
 
 bool State::addressHasCode(Address const& _id) const
 {
+    ++m_executionCounters.stateReads;
     if (auto a = account(_id))
         return a->codeHash() != EmptySHA3;
     else
@@ -311,6 +436,7 @@ bool State::addressHasCode(Address const& _id) const
 
 u256 State::balance(Address const& _id) const
 {
+    ++m_executionCounters.stateReads;
     if (auto a = account(_id))
         return a->balance();
     else
@@ -319,11 +445,12 @@ u256 State::balance(Address const& _id) const
 
 void State::incNonce(Address const& _addr)
 {
+    ++m_executionCounters.stateWrites;
     if (Account* a = account(_addr))
     {
-        auto oldNonce = a->nonce();
+        if (!loggedChange(Change::Nonce, _addr))
+            logChange({_addr, a->nonce()});
         a->incNonce();
-        m_changeLog.emplace_back(_addr, oldNonce);
     }
     else
         // This is possible if a transaction has gas price 0.
@@ -332,11 +459,12 @@ void State::incNonce(Address const& _addr)
 
 void State::setNonce(Address const& _addr, u256 const& _newNonce)
 {
+    ++m_executionCounters.stateWrites;
     if (Account* a = account(_addr))
     {
-        auto oldNonce = a->nonce();
+        if (!loggedChange(Change::Nonce, _addr))
+            logChange({_addr, a->nonce()});
         a->setNonce(_newNonce);
-        m_changeLog.emplace_back(_addr, oldNonce);
     }
     else
         // This is possible when a contract is being created.
@@ -345,6 +473,7 @@ void State::setNonce(Address const& _addr, u256 const& _newNonce)
 
 void State::addBalance(Address const& _id, u256 const& _amount)
 {
+    ++m_executionCounters.stateWrites;
     if (Account* a = account(_id))
     {
         // Log empty account being touched. Empty touched accounts are cleared
@@ -354,7 +483,7 @@ void State::addBalance(Address const& _id, u256 const& _amount)
         // TODO: to save space we can combine this event with Balance by having
         //       Balance and Balance+Touch events.
         if (!a->isDirty() && a->isEmpty())
-            m_changeLog.emplace_back(Change::Touch, _id);
+            logChange({Change::Touch, _id});
 
         // Increase the account balance. This also is done for value 0 to mark
         // the account as dirty. Dirty account are not removed from the cache
@@ -365,7 +494,13 @@ void State::addBalance(Address const& _id, u256 const& _amount)
         createAccount(_id, {requireAccountStartNonce(), _amount});
 
     if (_amount)
-        m_changeLog.emplace_back(Change::Balance, _id, _amount);
+    {
+        // Balance changes are logged as increments, add to the one logged already.
+        if (Change* change = loggedChange(Change::Balance, _id))
+            change->value += _amount;
+        else
+            logChange({Change::Balance, _id, _amount});
+    }
 }
 
 void State::subBalance(Address const& _addr, u256 const& _value)
@@ -393,19 +528,21 @@ void State::setBalance(Address const& _addr, u256 const& _value)
 
 void State::createContract(Address const& _address)
 {
+    ++m_executionCounters.stateWrites;
     createAccount(_address, {requireAccountStartNonce(), 0});
 }
 
 void State::createAccount(Address const& _address, Account const&& _account)
 {
-    assert(!addressInUse(_address) && "Account already exists");
+    assert(!account(_address) && "Account already exists");
     m_cache[_address] = std::move(_account);
     m_nonExistingAccountsCache.erase(_address);
-    m_changeLog.emplace_back(Change::Create, _address);
+    logChange({Change::Create, _address});
 }
 
 void State::kill(Address _addr)
 {
+    ++m_executionCounters.stateWrites;
     if (auto a = account(_addr))
         a->kill();
     // If the account is not in the db, nothing to kill.
@@ -413,6 +550,7 @@ void State::kill(Address _addr)
 
 u256 State::getNonce(Address const& _addr) const
 {
+    ++m_executionCounters.stateReads;
     if (auto a = account(_addr))
         return a->nonce();
     else
@@ -421,22 +559,45 @@ u256 State::getNonce(Address const& _addr) const
 
 u256 State::storage(Address const& _id, u256 const& _key) const
 {
+    ++m_executionCounters.stateReads;
     if (Account const* a = account(_id))
-        return a->storageValue(_key, m_db);
+        return storageValue(*a, _key);
     else
         return 0;
 }
 
+void State::storage(Address const& _id, u256 const* _keys, u256* o_values, size_t _count) const
+{
+    m_executionCounters.stateReads += _count;
+    Account const* a = account(_id);
+    for (size_t i = 0; i < _count; ++i)
+        o_values[i] = a ? storageValue(*a, _keys[i]) : 0;
+}
+
+u256 State::storageValue(Account const& _a, u256 const& _key, bool _original) const
+{
+    size_t const cached = _a.originalStorageCacheSize();
+    u256 const value = _original ? _a.originalStorageValue(_key, m_db) : _a.storageValue(_key, m_db);
+    m_executionCounters.dbMisses += _a.originalStorageCacheSize() - cached;
+    return value;
+}
+
 void State::setStorage(Address const& _contract, u256 const& _key, u256 const& _value)
 {
-    m_changeLog.emplace_back(_contract, _key, storage(_contract, _key));
+    ++m_executionCounters.stateWrites;
+    if (!loggedChange(Change::Storage, _contract, _key))
+    {
+        Account const* a = account(_contract);
+        logChange({_contract, _key, a ? storageValue(*a, _key) : 0});
+    }
     m_cache[_contract].setStorage(_key, _value);
 }
 
 u256 State::originalStorageValue(Address const& _contract, u256 const& _key) const
 {
+    ++m_executionCounters.stateReads;
     if (Account const* a = account(_contract))
-        return a->originalStorageValue(_key, m_db);
+        return storageValue(*a, _key, true);
     else
         return 0;
 }
@@ -446,7 +607,8 @@ void State::clearStorage(Address const& _contract)
     h256 const& oldHash{m_cache[_contract].baseRoot()};
     if (oldHash == EmptyTrie)
         return;
-    m_changeLog.emplace_back(Change::StorageRoot, _contract, oldHash);
+    ++m_executionCounters.stateWrites;
+    logChange({Change::StorageRoot, _contract, oldHash});
     m_cache[_contract].clearStorage();
 }
 
@@ -500,7 +662,42 @@ h256 State::storageRoot(Address const& _id) const
     return EmptyTrie;
 }
 
+AccountProof State::proof(Address const& _address, u256s const& _keys) const
+{
+    AccountProof ret;
+    TrieNodeCache cache;
+    string account;
+    ret.proof = m_state.proof(_address, &cache, &account);
+    if (account.size())
+    {
+        RLP r(account);
+        ret.nonce = r[0].toInt<u256>();
+        ret.balance = r[1].toInt<u256>();
+        ret.storageRoot = r[2].toHash<h256>();
+        ret.codeHash = r[3].toHash<h256>();
+    }
+
+    // Not verified: the empty storage trie of an account may not be in the database.
+    SecureTrieDB<h256, OverlayDB> const storageDB(const_cast<OverlayDB*>(&m_db), ret.storageRoot, Verification::Skip);  // promise we won't alter the overlay! :)
+    ret.storage.reserve(_keys.size());
+    for (auto const& key : _keys)
+    {
+        string value;
+        AccountProof::StorageProof p{key, 0, storageDB.proof(key, &cache, &value)};
+        if (value.size())
+            p.value = RLP(value).toInt<u256>();
+        ret.storage.push_back(move(p));
+    }
+    return ret;
+}
+
 bytes const& State::code(Address const& _addr) const
+{
+    ++m_executionCounters.stateReads;
+    return accountCode(_addr);
+}
+
+bytes const& State::accountCode(Address const& _addr) const
 {
     Account const* a = account(_addr);
     if (!a || a->codeHash() == EmptySHA3)
@@ -509,6 +706,7 @@ bytes const& State::code(Address const& _addr) const
     if (a->code().empty())
     {
         // Load the code from the backend.
+        ++m_executionCounters.dbMisses;
         Account* mutableAccount = const_cast<Account*>(a);
         mutableAccount->noteCode(m_db.lookup(a->codeHash()));
         CodeSizeCache::instance().store(a->codeHash(), a->code().size());
@@ -519,12 +717,14 @@ bytes const& State::code(Address const& _addr) const
 
 void State::setCode(Address const& _address, bytes&& _code)
 {
-    m_changeLog.emplace_back(_address, code(_address));
+    ++m_executionCounters.stateWrites;
+    logChange({_address, accountCode(_address)});
     m_cache[_address].setCode(std::move(_code));
 }
 
 h256 State::codeHash(Address const& _a) const
 {
+    ++m_executionCounters.stateReads;
     if (Account const* a = account(_a))
         return a->codeHash();
     else
@@ -533,6 +733,7 @@ h256 State::codeHash(Address const& _a) const
 
 size_t State::codeSize(Address const& _a) const
 {
+    ++m_executionCounters.stateReads;
     if (Account const* a = account(_a))
     {
         if (a->hasNewCode())
@@ -543,7 +744,7 @@ size_t State::codeSize(Address const& _a) const
             return codeSizeCache.get(codeHash);
         else
         {
-            size_t size = code(_a).size();
+            size_t size = accountCode(_a).size();
             codeSizeCache.store(codeHash, size);
             return size;
         }
@@ -554,14 +755,15 @@ size_t State::codeSize(Address const& _a) const
 
 size_t State::savepoint() const
 {
+    m_changeLogBarrier = m_changeLog.size();
     return m_changeLog.size();
 }
 
 void State::rollback(size_t _savepoint)
 {
-    while (_savepoint != m_changeLog.size())
+    for (size_t i = m_changeLog.size(); i > _savepoint; --i)
     {
-        auto& change = m_changeLog.back();
+        auto& change = m_changeLog[i - 1];
         auto& account = m_cache[change.address];
 
         // Public State API cannot be used here because it will add another
@@ -591,8 +793,80 @@ void State::rollback(size_t _savepoint)
             m_unchangedCacheEntries.emplace_back(change.address);
             break;
         }
-        m_changeLog.pop_back();
     }
+    m_changeLog.erase(m_changeLog.begin() + _savepoint, m_changeLog.end());
+    m_changeLogBarrier = _savepoint;
+}
+
+Change* State::loggedChange(Change::Kind _kind, Address const& _address, u256 const& _key)
+{
+    size_t const slot = changeLogIndexSlot(_kind, _address, _key);
+    if (!slot || slot - 1 < m_changeLogBarrier)
+        return nullptr;
+    return &m_changeLog[slot - 1];
+}
+
+void State::logChange(Change&& _change)
+{
+    if (_change.kind == Change::Balance || _change.kind == Change::Nonce ||
+        _change.kind == Change::Storage)
+    {
+        size_t* slot = &changeLogIndexSlot(_change.kind, _change.address, _change.key);
+        if (!*slot)
+        {
+            // Keep the index at most half full, so that probing stays short.
+            if (2 * (m_changeLogIndexUsed + 1) > m_changeLogIndex.size())
+            {
+                growChangeLogIndex();
+                slot = &changeLogIndexSlot(_change.kind, _change.address, _change.key);
+            }
+            ++m_changeLogIndexUsed;
+        }
+        *slot = m_changeLog.size() + 1;
+    }
+    else if (_change.kind == Change::Create)
+        // Changes of a created account are undone before its creation.
+        m_changeLogBarrier = m_changeLog.size();
+    m_changeLog.push_back(std::move(_change));
+}
+
+size_t& State::changeLogIndexSlot(Change::Kind _kind, Address const& _address, u256 const& _key)
+{
+    if (m_changeLogIndex.empty())
+        m_changeLogIndex.assign(c_changeLogIndexSize, 0);
+
+    size_t const mask = m_changeLogIndex.size() - 1;
+    for (size_t i = changeHash(_kind, _address, _key) & mask;; i = (i + 1) & mask)
+    {
+        size_t& slot = m_changeLogIndex[i];
+        if (!slot)
+            return slot;
+        // The entry may have been rolled back and its position reused.
+        if (slot <= m_changeLog.size())
+        {
+            Change const& change = m_changeLog[slot - 1];
+            if (change.kind == _kind && change.address == _address && change.key == _key)
+                return slot;
+        }
+    }
+}
+
+void State::growChangeLogIndex()
+{
+    vector<size_t> old(max(2 * m_changeLogIndex.size(), c_changeLogIndexSize), 0);
+    old.swap(m_changeLogIndex);
+    m_changeLogIndexUsed = 0;
+    for (size_t position : old)
+        if (position && position <= m_changeLog.size())
+        {
+            Change const& change = m_changeLog[position - 1];
+            size_t& slot = changeLogIndexSlot(change.kind, change.address, change.key);
+            if (!slot)
+            {
+                slot = position;
+                ++m_changeLogIndexUsed;
+            }
+        }
 }
 
 std::pair<ExecutionResult, TransactionReceipt> State::execute(EnvInfo const& _envInfo, SealEngineFace const& _sealEngine, Transaction const& _t, Permanence _p, OnOpFunc const& _onOp)
@@ -634,9 +908,10 @@ std::pair<ExecutionResult, TransactionReceipt> State::execute(EnvInfo const& _en
 void State::executeBlockTransactions(Block const& _block, unsigned _txCount, LastBlockHashesFace const& _lastHashes, SealEngineFace const& _sealEngine)
 {
     u256 gasUsed = 0;
+    EnvInfo envInfo(_block.info(), _lastHashes, gasUsed);
     for (unsigned i = 0; i < _txCount; ++i)
     {
-        EnvInfo envInfo(_block.info(), _lastHashes, gasUsed);
+        envInfo.setGasUsed(gasUsed);
 
         Executive e(*this, envInfo, _sealEngine);
         executeTransaction(e, _block.pending()[i], OnOpFunc());
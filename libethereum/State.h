@@ -18,9 +18,12 @@
 #pragma once
 
 #include "Account.h"
+#include "AccountProof.h"
 #include "GasPricer.h"
 #include "SecureTrieDB.h"
+#include "StateDiff.h"
 #include "Transaction.h"
+#include "TransactionPerformance.h"
 #include "TransactionReceipt.h"
 #include <libdevcore/Common.h>
 #include <libdevcore/OverlayDB.h>
@@ -30,6 +33,7 @@
 #include <libethereum/CodeSizeCache.h>
 #include <libevm/ExtVMFace.h>
 #include <array>
+#include <memory>
 #include <unordered_map>
 
 namespace dev
@@ -78,6 +82,7 @@ enum class Permanence
 
 DEV_SIMPLE_EXCEPTION(InvalidAccountStartNonceInState);
 DEV_SIMPLE_EXCEPTION(IncorrectAccountStartNonceInState);
+DEV_SIMPLE_EXCEPTION(InvalidStateDiffRoot);
 
 class SealEngineFace;
 class Executive;
@@ -152,9 +157,13 @@ using ChangeLog = std::vector<Change>;
  * # State Changelog
  *
  * Any atomic change to any account is registered and appended in the changelog.
- * In case some changes must be reverted, the changes are popped from the
- * changelog and undone. For possible atomic changes list @see Change::Kind.
+ * In case some changes must be reverted, the changes are undone in reverse order
+ * and the changelog is truncated. For possible atomic changes list @see Change::Kind.
  * The changelog is managed by savepoint(), rollback() and commit() methods.
+ *
+ * Only the first change of a balance, nonce or storage slot after the last savepoint
+ * is logged: undoing it restores the value anyway. The changelog keeps its capacity
+ * across commits, so logging does not allocate once it has grown to fit a transaction.
  */
 class State
 {
@@ -257,6 +266,10 @@ public:
     /// @returns 0 if no account exists at that address.
     u256 storage(Address const& _contract, u256 const& _memory) const;
 
+    /// Get the values of @a _count storage positions of an account into @a o_values.
+    /// The values are 0 if no account exists at that address.
+    void storage(Address const& _contract, u256 const* _keys, u256* o_values, size_t _count) const;
+
     /// Set the value of a storage position of an account.
     void setStorage(Address const& _contract, u256 const& _location, u256 const& _value);
 
@@ -309,6 +322,11 @@ public:
     /// The hash of the root of our state tree.
     h256 rootHash() const { return m_state.root(); }
 
+    /// @returns the Merkle proof of the account @a _address and of its storage slots @a _keys.
+    /// The trie nodes common to several proofs are looked up only once.
+    /// @note Only committed changes are reflected.
+    AccountProof proof(Address const& _address, u256s const& _keys) const;
+
     /// Commit all changes waiting in the address cache to the DB.
     /// @param _commitBehaviour whether or not to remove empty accounts during commit.
     void commit(CommitBehaviour _commitBehaviour);
@@ -330,6 +348,27 @@ public:
 
     ChangeLog const& changeLog() const { return m_changeLog; }
 
+    /// @returns the counts of the work done through this state since resetExecutionCounters().
+    ExecutionCounters const& executionCounters() const { return m_executionCounters; }
+    void resetExecutionCounters() { m_executionCounters = ExecutionCounters(); }
+
+    /// Counts a call of the precompiled contract at @a _address.
+    void notePrecompileCall(Address const& _address) { ++m_executionCounters.precompiles[_address]; }
+
+    /// Start recording the account changes committed to the trie into a StateDiff.
+    /// The recording restarts from the new root on every setRoot().
+    void startStateDiff() { m_stateDiff.reset(new StateDiff(rootHash())); }
+
+    /// Stop recording the account changes.
+    /// @returns the changes committed since the recording started or NullStateDiff if not recording.
+    StateDiff takeStateDiff();
+
+    /// Write the accounts of @a _diff directly into the trie, moving its root from
+    /// _diff.rootBefore to _diff.rootAfter or the other way round if @a _direction is Revert.
+    /// The storage tries and the code referred to by the diff must be present in the database.
+    /// @throws InvalidStateDiffRoot if the trie root doesn't match the diff.
+    void applyStateDiff(StateDiff const& _diff, StateDiffDirection _direction);
+
 private:
     /// Turns all "touched" empty accounts into non-alive accounts.
     void removeEmptyAccounts();
@@ -342,9 +381,22 @@ private:
     /// The pointer is valid until the next access to the state or account.
     Account* account(Address const& _addr);
 
+    /// Records the pre-commit trie values of the dirty accounts in m_cache into m_stateDiff.
+    void noteStateDiffBefore();
+
+    /// Records the post-commit trie values of the dirty accounts in m_cache into m_stateDiff.
+    void noteStateDiffAfter();
+
     /// Purges non-modified entries in m_cache if it grows too large.
     void clearCacheIfTooLarge() const;
 
+    /// @returns the current or, if @a _original, the committed value of a storage slot of @a _a,
+    /// counting the slots loaded from the DB.
+    u256 storageValue(Account const& _a, u256 const& _key, bool _original = false) const;
+
+    /// @returns the code of @a _addr like code(), without counting it as a state read.
+    bytes const& accountCode(Address const& _addr) const;
+
     void createAccount(Address const& _address, Account const&& _account);
 
     /// @returns true when normally halted; false when exceptionally halted; throws when internal VM
@@ -367,8 +419,36 @@ private:
 
     u256 m_accountStartNonce;
 
+    mutable ExecutionCounters m_executionCounters;
+
+    /// @returns the entry saving what @a _kind changes of @a _address (at @a _key), if it was
+    /// logged since the last savepoint, or nullptr.
+    Change* loggedChange(Change::Kind _kind, Address const& _address, u256 const& _key = 0);
+
+    /// Appends @a _change to the changelog.
+    void logChange(Change&& _change);
+
+    /// @returns the slot of m_changeLogIndex pointing at an entry saving what @a _kind changes of
+    /// @a _address (at @a _key), or the empty slot where such a pointer belongs.
+    size_t& changeLogIndexSlot(Change::Kind _kind, Address const& _address, u256 const& _key);
+
+    /// Doubles the size of m_changeLogIndex, dropping its stale slots.
+    void growChangeLogIndex();
+
     friend std::ostream& operator<<(std::ostream& _out, State const& _s);
     ChangeLog m_changeLog;
+    /// Open-addressing index of the last entry of m_changeLog saving a balance, nonce or storage
+    /// slot: each slot holds its position + 1, or 0 if empty. Slots are checked against the entry
+    /// they point at, so the ones left stale by rollback() are skipped. Its size is a power of two
+    /// and it keeps its capacity across commits, so it does not allocate once grown.
+    std::vector<size_t> m_changeLogIndex;
+    size_t m_changeLogIndexUsed = 0;
+    /// Entries of m_changeLog before this position may be undone separately from newer ones,
+    /// so later changes are not folded into them.
+    mutable size_t m_changeLogBarrier = 0;
+
+    /// The changes committed since startStateDiff(), if recording.
+    std::unique_ptr<StateDiff> m_stateDiff;
 };
 
 std::ostream& operator<<(std::ostream& _out, State const& _s);
@@ -0,0 +1,71 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "StateDiff.h"
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+void streamSnapshot(RLPStream& _s, AccountSnapshot const& _a)
+{
+    if (!_a.exists)
+    {
+        _s.appendList(0);
+        return;
+    }
+    _s.appendList(4) << _a.nonce << _a.balance << _a.storageRoot << _a.codeHash;
+}
+}  // namespace
+
+AccountSnapshot::AccountSnapshot(RLP const& _r)
+{
+    if (_r.isNull() || _r.isEmpty())
+        return;
+    exists = true;
+    nonce = _r[0].toInt<u256>();
+    balance = _r[1].toInt<u256>();
+    storageRoot = _r[2].toHash<h256>();
+    codeHash = _r[3].toHash<h256>();
+}
+
+bytes AccountSnapshot::trieRLP() const
+{
+    RLPStream s;
+    streamSnapshot(s, *this);
+    return s.out();
+}
+
+StateDiff::StateDiff(RLP const& _r)
+{
+    rootBefore = _r[0].toHash<h256>();
+    rootAfter = _r[1].toHash<h256>();
+    for (auto const& a : _r[2])
+    {
+        AccountDiff& diff = accounts[a[0].toHash<Address>()];
+        diff.before = AccountSnapshot(a[1]);
+        diff.after = AccountSnapshot(a[2]);
+        for (auto const& slot : a[3])
+            diff.storage[slot[0].toInt<u256>()] = {slot[1].toInt<u256>(), slot[2].toInt<u256>()};
+    }
+}
+
+bytes StateDiff::rlp() const
+{
+    RLPStream s(3);
+    s << rootBefore << rootAfter;
+    s.appendList(accounts.size());
+    for (auto const& a : accounts)
+    {
+        s.appendList(4) << a.first;
+        streamSnapshot(s, a.second.before);
+        streamSnapshot(s, a.second.after);
+        s.appendList(a.second.storage.size());
+        for (auto const& slot : a.second.storage)
+            s.appendList(3) << slot.first << slot.second.first << slot.second.second;
+    }
+    return s.out();
+}
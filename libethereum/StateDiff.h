@@ -0,0 +1,91 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Compact record of the state changes made by a single block.
+#pragma once
+
+#include <libdevcore/Address.h>
+#include <libdevcore/Common.h>
+#include <libdevcore/RLP.h>
+#include <libdevcore/SHA3.h>
+#include <libdevcore/TrieCommon.h>
+
+#include <map>
+
+namespace dev
+{
+namespace eth
+{
+enum class StateDiffDirection
+{
+    Forward,  ///< Move the state from rootBefore to rootAfter.
+    Revert    ///< Move the state from rootAfter back to rootBefore.
+};
+
+/// The fields of an account as they are stored in the state trie.
+struct AccountSnapshot
+{
+    AccountSnapshot() = default;
+    AccountSnapshot(
+        u256 const& _nonce, u256 const& _balance, h256 const& _storageRoot, h256 const& _codeHash)
+      : exists(true),
+        nonce(_nonce),
+        balance(_balance),
+        storageRoot(_storageRoot),
+        codeHash(_codeHash)
+    {}
+
+    /// Decodes the account from its state trie RLP. An empty RLP is a non-existing account.
+    explicit AccountSnapshot(RLP const& _r);
+
+    bool operator==(AccountSnapshot const& _c) const
+    {
+        return exists == _c.exists && nonce == _c.nonce && balance == _c.balance &&
+               storageRoot == _c.storageRoot && codeHash == _c.codeHash;
+    }
+    bool operator!=(AccountSnapshot const& _c) const { return !operator==(_c); }
+
+    /// @returns the RLP of the account as it is stored in the state trie.
+    bytes trieRLP() const;
+
+    bool exists = false;
+    u256 nonce;
+    u256 balance;
+    h256 storageRoot = EmptyTrie;
+    h256 codeHash = EmptySHA3;
+};
+
+/// Changes of a single account within a block.
+/// The storage roots are authoritative for reverting, the list of slots is informational (it lists
+/// the slots written by the block, but not the ones dropped by wholesale storage clears).
+struct AccountDiff
+{
+    AccountSnapshot before;
+    AccountSnapshot after;
+    /// Storage key => (value before the block, value after the block).
+    std::map<u256, std::pair<u256, u256>> storage;
+};
+
+/// All account changes made by a block, applicable in both directions on top of
+/// a state trie which has rootBefore or rootAfter as its root respectively.
+struct StateDiff
+{
+    StateDiff() {}
+    explicit StateDiff(h256 const& _rootBefore): rootBefore(_rootBefore), rootAfter(_rootBefore) {}
+    explicit StateDiff(RLP const& _r);
+    bytes rlp() const;
+
+    bool isNull() const { return !rootBefore; }
+    explicit operator bool() const { return !isNull(); }
+
+    h256 rootBefore;
+    h256 rootAfter;
+    std::map<Address, AccountDiff> accounts;
+};
+
+static const StateDiff NullStateDiff;
+
+}  // namespace eth
+}  // namespace dev
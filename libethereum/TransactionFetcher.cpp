@@ -0,0 +1,150 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "TransactionFetcher.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// Announcements tracked at most; further ones are ignored until some are fetched.
+size_t const c_maxAnnounced = 16384;
+
+/// Peers remembered for each announced transaction.
+size_t const c_maxAnnouncers = 8;
+
+/// Transactions remembered as fetched.
+size_t const c_maxFetched = 16384;
+
+/// Time a peer has to deliver the transactions requested from it.
+chrono::seconds const c_requestTimeout{5};
+}  // namespace
+
+void TransactionFetcher::noteAnnounced(NodeID const& _peer, h256s const& _hashes)
+{
+    for (auto const& h : _hashes)
+    {
+        if (m_fetched.count(h))
+            continue;
+
+        auto it = m_announced.find(h);
+        if (it == m_announced.end())
+        {
+            if (m_announced.size() >= c_maxAnnounced)
+                continue;
+            it = m_announced.emplace(h, Announcement()).first;
+        }
+
+        Announcement& a = it->second;
+        if (a.requestedFrom != _peer && a.peers.size() < c_maxAnnouncers &&
+            find(a.peers.begin(), a.peers.end(), _peer) == a.peers.end())
+            a.peers.push_back(_peer);
+    }
+}
+
+unordered_map<NodeID, h256s> TransactionFetcher::takeRequests(Clock::time_point _now)
+{
+    unordered_map<NodeID, h256s> ret;
+    for (auto it = m_announced.begin(); it != m_announced.end();)
+    {
+        Announcement& a = it->second;
+        if (a.requestedFrom)
+        {
+            if (_now - a.requestedAt < c_requestTimeout)
+            {
+                ++it;
+                continue;
+            }
+            m_inFlight[a.requestedFrom].erase(it->first);
+            a.requestedFrom = NodeID();
+        }
+
+        if (a.peers.empty())
+        {
+            it = m_announced.erase(it);
+            continue;
+        }
+
+        // Ask the first announcer with no request in flight, or one being asked in this round.
+        for (auto p = a.peers.begin(); p != a.peers.end(); ++p)
+        {
+            auto const r = ret.find(*p);
+            bool const idle = r == ret.end() ? m_inFlight[*p].empty() :
+                                               r->second.size() < c_maxPooledTransactionsAsk;
+            if (idle)
+            {
+                ret[*p].push_back(it->first);
+                a.requestedFrom = *p;
+                a.requestedAt = _now;
+                a.peers.erase(p);
+                break;
+            }
+        }
+        ++it;
+    }
+
+    for (auto const& r : ret)
+        m_inFlight[r.first] = h256Hash(r.second.begin(), r.second.end());
+    return ret;
+}
+
+bool TransactionFetcher::noteDelivered(NodeID const& _peer, h256s const& _hashes)
+{
+    bool solicited = true;
+    auto inFlight = m_inFlight.find(_peer);
+    for (auto const& h : _hashes)
+    {
+        if (inFlight == m_inFlight.end() || !inFlight->second.erase(h))
+            solicited = false;
+        m_announced.erase(h);
+        noteFetched(h);
+    }
+
+    if (inFlight != m_inFlight.end())
+    {
+        // The peer doesn't have the rest any more.
+        for (auto const& h : inFlight->second)
+            abandonRequest(_peer, h);
+        m_inFlight.erase(inFlight);
+    }
+    return solicited;
+}
+
+void TransactionFetcher::notePeerGone(NodeID const& _peer)
+{
+    auto inFlight = m_inFlight.find(_peer);
+    if (inFlight != m_inFlight.end())
+    {
+        for (auto const& h : inFlight->second)
+            abandonRequest(_peer, h);
+        m_inFlight.erase(inFlight);
+    }
+
+    for (auto& a : m_announced)
+        a.second.peers.erase(
+            remove(a.second.peers.begin(), a.second.peers.end(), _peer), a.second.peers.end());
+}
+
+void TransactionFetcher::abandonRequest(NodeID const& _peer, h256 const& _hash)
+{
+    auto it = m_announced.find(_hash);
+    if (it != m_announced.end() && it->second.requestedFrom == _peer)
+        it->second.requestedFrom = NodeID();
+}
+
+void TransactionFetcher::noteFetched(h256 const& _hash)
+{
+    if (!m_fetched.insert(_hash).second)
+        return;
+    m_fetchedOrder.push_back(_hash);
+    if (m_fetchedOrder.size() > c_maxFetched)
+    {
+        m_fetched.erase(m_fetchedOrder.front());
+        m_fetchedOrder.pop_front();
+    }
+}
@@ -0,0 +1,74 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Tracks the transactions announced by hash by the peers and decides which peer to fetch each
+/// of them from.
+#pragma once
+
+#include "CommonNet.h"
+
+#include <libdevcore/FixedHash.h>
+
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * @brief Fetches each announced transaction from one peer at a time.
+ *
+ * A transaction announced by several peers is requested from only one of them; if that peer
+ * doesn't deliver it in time or replies without it, it is requested from the next one. Each peer
+ * has at most one request in flight, so that a reply can be matched with its request.
+ * @warning Not thread-safe; used only on the network thread, as EthereumCapability.
+ */
+class TransactionFetcher
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Notes that @a _peer has the transactions @a _hashes, which we don't have.
+    void noteAnnounced(NodeID const& _peer, h256s const& _hashes);
+
+    /// @returns the hashes to request from each peer: every announced transaction which is not
+    /// being fetched, or whose request timed out, is assigned to a peer that announced it.
+    std::unordered_map<NodeID, h256s> takeRequests(Clock::time_point _now = Clock::now());
+
+    /// Notes the transactions @a _peer sent. The ones it was asked for and didn't send are asked
+    /// from another peer. @returns false if it sent transactions it was not asked for.
+    bool noteDelivered(NodeID const& _peer, h256s const& _hashes);
+
+    /// Forgets the announcements of @a _peer and retries its request with other peers.
+    void notePeerGone(NodeID const& _peer);
+
+    /// @returns the number of announced transactions not fetched yet.
+    size_t size() const { return m_announced.size(); }
+
+private:
+    struct Announcement
+    {
+        std::vector<NodeID> peers;  ///< Peers which announced it and weren't asked for it yet.
+        NodeID requestedFrom;       ///< Peer it is being fetched from, if any.
+        Clock::time_point requestedAt;
+    };
+
+    /// Returns the hash, requested from @a _peer, to the announcements to be requested again.
+    void abandonRequest(NodeID const& _peer, h256 const& _hash);
+    void noteFetched(h256 const& _hash);
+
+    std::unordered_map<h256, Announcement> m_announced;
+    std::unordered_map<NodeID, h256Hash> m_inFlight;  ///< Hashes of the request pending with each peer.
+
+    /// Transactions fetched recently, not announced again while they are being imported.
+    h256Hash m_fetched;
+    std::deque<h256> m_fetchedOrder;
+};
+
+}  // namespace eth
+}  // namespace dev
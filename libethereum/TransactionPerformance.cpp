@@ -0,0 +1,80 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "TransactionPerformance.h"
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Log.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+string precompilesToString(map<Address, unsigned> const& _precompiles)
+{
+    string ret;
+    for (auto const& p : _precompiles)
+        ret += (ret.empty() ? "" : ",") + p.first.hex() + ":" + toString(p.second);
+    return ret;
+}
+}  // namespace
+
+TransactionPerformanceLog& TransactionPerformanceLog::instance()
+{
+    static TransactionPerformanceLog s_log;
+    return s_log;
+}
+
+void TransactionPerformanceLog::enable(size_t _capacity, boost::filesystem::path const& _file)
+{
+    Guard l(x_records);
+    m_ring = vector<TransactionPerformance>(_capacity);
+    m_next = 0;
+    m_count = 0;
+
+    if (m_file.is_open())
+        m_file.close();
+    if (_capacity && !_file.empty())
+    {
+        m_file.open(_file, ios::app);
+        if (!m_file)
+            cwarn << "Cannot open " << _file.string() << " for the transaction performance records";
+        else if (m_file.tellp() == 0)
+            m_file << "block\tindex\ttransaction\tto\tmicroseconds\tgasUsed\tstateReads\tstateWrites"
+                      "\tdbMisses\tvm\tprecompiles\n";
+    }
+    m_enabled = _capacity > 0;
+}
+
+void TransactionPerformanceLog::record(TransactionPerformance&& _record)
+{
+    Guard l(x_records);
+    if (m_ring.empty())
+        return;
+
+    if (m_file.is_open())
+        m_file << _record.blockNumber << '\t' << _record.index << '\t' << _record.transaction.hex()
+               << '\t' << _record.to.hex() << '\t' << _record.microseconds << '\t'
+               << _record.gasUsed << '\t' << _record.counters.stateReads << '\t'
+               << _record.counters.stateWrites << '\t' << _record.counters.dbMisses << '\t'
+               << _record.vm << '\t' << precompilesToString(_record.counters.precompiles) << '\n';
+
+    m_ring[m_next] = move(_record);
+    m_next = (m_next + 1) % m_ring.size();
+    if (m_count < m_ring.size())
+        ++m_count;
+}
+
+vector<TransactionPerformance> TransactionPerformanceLog::records(size_t _max) const
+{
+    Guard l(x_records);
+    size_t const n = _max && _max < m_count ? _max : m_count;
+    vector<TransactionPerformance> ret;
+    ret.reserve(n);
+    for (size_t i = m_ring.size() + m_next - n; ret.size() < n; ++i)
+        ret.push_back(m_ring[i % m_ring.size()]);
+    return ret;
+}
@@ -0,0 +1,81 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Per-transaction performance records of the blocks imported into the chain.
+#pragma once
+
+#include <libdevcore/Address.h>
+#include <libdevcore/Common.h>
+#include <libdevcore/Guards.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+/// Counts of the work done by the execution of a transaction, gathered by State and Executive.
+struct ExecutionCounters
+{
+    uint64_t stateReads = 0;   ///< Reads of accounts, storage slots and code.
+    uint64_t stateWrites = 0;  ///< Changes of balances, nonces, storage and code.
+    uint64_t dbMisses = 0;     ///< Accounts, storage slots and code loaded from the state DB.
+    std::map<Address, unsigned> precompiles;  ///< Calls of each precompiled contract.
+};
+
+/// The cost of executing one transaction of an imported block.
+struct TransactionPerformance
+{
+    h256 transaction;
+    unsigned blockNumber = 0;
+    unsigned index = 0;        ///< Position of the transaction in its block.
+    Address to;                ///< The recipient, or the null address for a contract creation.
+    uint64_t microseconds = 0;  ///< Wall time of the execution.
+    u256 gasUsed;
+    ExecutionCounters counters;
+    std::string vm;            ///< Name of the VM the transaction was executed with.
+};
+
+/**
+ * @brief Keeps the performance records of the last transactions imported.
+ *
+ * Recording is off until enable() is called. The records are kept in a ring buffer and, if a file
+ * is given, also appended to it as tab-separated lines.
+ * @threadsafe
+ */
+class TransactionPerformanceLog
+{
+public:
+    /// @returns the log the imported blocks are recorded into.
+    static TransactionPerformanceLog& instance();
+
+    /// Keeps the last @a _capacity records, and appends every record to @a _file if not empty.
+    /// A capacity of 0 stops recording and drops the records kept.
+    void enable(size_t _capacity, boost::filesystem::path const& _file = {});
+
+    bool enabled() const { return m_enabled; }
+
+    void record(TransactionPerformance&& _record);
+
+    /// @returns up to @a _max of the latest records, oldest first; all of them if @a _max is 0.
+    std::vector<TransactionPerformance> records(size_t _max = 0) const;
+
+private:
+    mutable Mutex x_records;
+    std::vector<TransactionPerformance> m_ring;
+    size_t m_next = 0;   ///< Position in m_ring the next record is written to.
+    size_t m_count = 0;  ///< Number of records kept, at most m_ring.size().
+    boost::filesystem::ofstream m_file;
+    std::atomic<bool> m_enabled = {false};
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -29,14 +29,24 @@ using namespace dev;
 using namespace dev::eth;
 
 const size_t c_maxVerificationQueueSize = 8192;
+const size_t c_maxVerificationBatchSize = 256;
+/// A transaction replacing a queued one must raise its gas price by this many percent.
+const unsigned c_priceBumpPercent = 10;
 
-TransactionQueue::TransactionQueue(unsigned _limit, unsigned _futureLimit):
+namespace
+{
+bool isPriceBumped(u256 const& _newPrice, u256 const& _oldPrice)
+{
+    return bigint(_newPrice) * 100 >= bigint(_oldPrice) * (100 + c_priceBumpPercent);
+}
+}
+
+TransactionQueue::TransactionQueue(Limits const& _l):
     m_current(PriorityCompare { *this }),
-    m_limit(_limit),
-    m_futureLimit(_futureLimit)
+    m_limits(_l),
+    m_verifierCount(std::max(thread::hardware_concurrency(), 3U) - 2U)
 {
-    unsigned verifierThreads = std::max(thread::hardware_concurrency(), 3U) - 2U;
-    for (unsigned i = 0; i < verifierThreads; ++i)
+    for (unsigned i = 0; i < m_verifierCount; ++i)
         m_verifiers.emplace_back([=](){
             setThreadName("txcheck" + toString(i));
             this->verifierBody();
@@ -84,6 +94,7 @@ ImportResult TransactionQueue::import(Transaction const& _transaction, IfDropped
     h256 h = _transaction.sha3(WithSignature);
 
     ImportResult ret;
+    PendingSignals signals;
     {
         UpgradableGuard l(m_lock);
         auto ir = check_WITH_LOCK(h, _ik);
@@ -93,12 +104,73 @@ ImportResult TransactionQueue::import(Transaction const& _transaction, IfDropped
         {
             _transaction.safeSender();  // Perform EC recovery outside of the write lock
             UpgradeGuard ul(l);
-            ret = manageImport_WITH_LOCK(h, _transaction);
+            ret = manageImport_WITH_LOCK(h, _transaction, signals);
         }
     }
+    emitSignals(signals);
     return ret;
 }
 
+void TransactionQueue::importBatch(std::vector<UnverifiedTransaction> const& _batch)
+{
+    struct Work
+    {
+        Transaction transaction;
+        h256 hash;
+        h512 nodeId;
+        ImportResult result;
+    };
+
+    vector<Work> work;
+    work.reserve(_batch.size());
+    for (UnverifiedTransaction const& u : _batch)
+        try
+        {
+            // Signature is checked below.
+            Transaction t(u.transaction, CheckTransaction::Cheap);
+            ImportResult const ir = t.hasZeroSignature() ? ImportResult::ZeroSignature : ImportResult::Success;
+            h256 const h = t.sha3();
+            work.push_back(Work{move(t), h, u.nodeId, ir});
+        }
+        catch (Exception const& _e)
+        {
+            LOG(m_loggerDetail) << "Ignoring invalid transaction: " << diagnostic_information(_e);
+        }
+
+    // Skip the transactions we already know about before paying for their EC recovery.
+    DEV_READ_GUARDED(m_lock)
+        for (Work& w : work)
+            if (w.result == ImportResult::Success)
+                w.result = check_WITH_LOCK(w.hash, IfDropped::Ignore);
+
+    for (Work& w : work)
+        if (w.result == ImportResult::Success && !w.transaction.safeSender())
+            w.result = ImportResult::Malformed;
+
+    PendingSignals signals;
+    DEV_WRITE_GUARDED(m_lock)
+        for (Work& w : work)
+            if (w.result == ImportResult::Success)
+            {
+                // The transaction may have been imported since, possibly from the same batch.
+                w.result = check_WITH_LOCK(w.hash, IfDropped::Ignore);
+                if (w.result == ImportResult::Success)
+                    w.result = manageImport_WITH_LOCK(w.hash, w.transaction, signals);
+            }
+
+    emitSignals(signals);
+    for (Work const& w : work)
+        m_onImport(w.result, w.hash, w.nodeId);
+}
+
+void TransactionQueue::emitSignals(PendingSignals const& _signals)
+{
+    for (h256 const& replaced : _signals.replaced)
+        m_onReplaced(replaced);
+    if (_signals.ready)
+        m_onReady();
+}
+
 Transactions TransactionQueue::topTransactions(unsigned _limit, h256Hash const& _avoid) const
 {
     ReadGuard l(m_lock);
@@ -115,57 +187,69 @@ h256Hash TransactionQueue::knownTransactions() const
     return m_known;
 }
 
-ImportResult TransactionQueue::manageImport_WITH_LOCK(h256 const& _h, Transaction const& _transaction)
+bool TransactionQueue::isKnown(h256 const& _txHash) const
+{
+    ReadGuard l(m_lock);
+    return m_known.count(_txHash) || m_dropped.count(_txHash);
+}
+
+bytes TransactionQueue::currentTransactionRLP(h256 const& _txHash) const
+{
+    ReadGuard l(m_lock);
+    auto it = m_currentByHash.find(_txHash);
+    return it != m_currentByHash.end() ? it->second->transaction.rlp() : bytes();
+}
+
+ImportResult TransactionQueue::manageImport_WITH_LOCK(
+    h256 const& _h, Transaction const& _transaction, PendingSignals& o_signals)
 {
     try
     {
         assert(_h == _transaction.sha3());
-        // Remove any prior transaction with the same nonce but a lower gas price.
-        // Bomb out if there's a prior transaction with higher gas price.
-        auto cs = m_currentByAddressAndNonce.find(_transaction.from());
-        if (cs != m_currentByAddressAndNonce.end())
+        // Remove any prior transaction with the same nonce and a sufficiently lower gas price.
+        // Bomb out if the gas price of the prior transaction is not outbid.
+        Address const& from = _transaction.from();
+        auto cs = m_currentByAddressAndNonce.find(from);
+        auto const currentPrior = cs != m_currentByAddressAndNonce.end() ?
+                                      cs->second.find(_transaction.nonce()) :
+                                      std::map<u256, PriorityQueue::iterator>::iterator();
+        bool const hasCurrentPrior = cs != m_currentByAddressAndNonce.end() && currentPrior != cs->second.end();
+        if (hasCurrentPrior && !isPriceBumped(_transaction.gasPrice(), (*currentPrior->second).transaction.gasPrice()))
+            return ImportResult::OverbidGasPrice;
+
+        auto fs = m_future.find(from);
+        bool const hasFuturePrior = fs != m_future.end() && fs->second.count(_transaction.nonce());
+        if (hasFuturePrior && !isPriceBumped(_transaction.gasPrice(), fs->second.at(_transaction.nonce()).transaction.gasPrice()))
+            return ImportResult::OverbidGasPrice;
+
+        if (!hasCurrentPrior && !hasFuturePrior)
         {
-            auto t = cs->second.find(_transaction.nonce());
-            if (t != cs->second.end())
-            {
-                if (_transaction.gasPrice() < (*t->second).transaction.gasPrice())
-                    return ImportResult::OverbidGasPrice;
-                else
-                {
-                    h256 dropped = (*t->second).transaction.sha3();
-                    remove_WITH_LOCK(dropped);
-                    m_onReplaced(dropped);
-                }
-            }
+            size_t queued = cs != m_currentByAddressAndNonce.end() ? cs->second.size() : 0;
+            if (fs != m_future.end())
+                queued += fs->second.size();
+            if (queued >= m_limits.perSender)
+                return ImportResult::TooManyFromSender;
         }
-        auto fs = m_future.find(_transaction.from());
-        if (fs != m_future.end())
+
+        if (hasCurrentPrior)
         {
-            auto t = fs->second.find(_transaction.nonce());
-            if (t != fs->second.end())
-            {
-                if (_transaction.gasPrice() < t->second.transaction.gasPrice())
-                    return ImportResult::OverbidGasPrice;
-                else
-                {
-                    fs->second.erase(t);
-                    --m_futureSize;
-                    if (fs->second.empty())
-                        m_future.erase(fs);
-                }
-            }
+            h256 dropped = (*currentPrior->second).transaction.sha3();
+            remove_WITH_LOCK(dropped);
+            o_signals.replaced.push_back(dropped);
         }
+        if (hasFuturePrior)
+            removeFuture_WITH_LOCK(from, _transaction.nonce(), false);
+
         // If valid, append to transactions.
-        insertCurrent_WITH_LOCK(make_pair(_h, _transaction));
+        insertCurrent_WITH_LOCK(make_pair(_h, _transaction), o_signals);
         LOG(m_loggerDetail) << "Queued vaguely legit-looking transaction " << _h;
 
-        while (m_current.size() > m_limit)
-        {
-            LOG(m_loggerDetail) << "Dropping out of bounds transaction " << _h;
-            remove_WITH_LOCK(m_current.rbegin()->transaction.sha3());
-        }
+        enforceLimits_WITH_LOCK();
+        if (!m_known.count(_h))
+            // It was the worst transaction in the full queue.
+            return ImportResult::QueueFull;
 
-        m_onReady();
+        o_signals.ready = true;
     }
     catch (Exception const& _e)
     {
@@ -199,7 +283,8 @@ u256 TransactionQueue::maxNonce_WITH_LOCK(Address const& _a) const
     return ret;
 }
 
-void TransactionQueue::insertCurrent_WITH_LOCK(std::pair<h256, Transaction> const& _p)
+void TransactionQueue::insertCurrent_WITH_LOCK(
+    std::pair<h256, Transaction> const& _p, PendingSignals& o_signals)
 {
     if (m_currentByHash.count(_p.first))
     {
@@ -213,10 +298,12 @@ void TransactionQueue::insertCurrent_WITH_LOCK(std::pair<h256, Transaction> cons
     PriorityQueue::iterator handle = m_current.emplace(VerifiedTransaction(t));
     inserted.first->second = handle;
     m_currentByHash[_p.first] = handle;
+    m_currentBytes += handle->size;
+    m_known.insert(_p.first);
 
     // Move following transactions from future to current
-    makeCurrent_WITH_LOCK(t);
-    m_known.insert(_p.first);
+    if (makeCurrent_WITH_LOCK(t))
+        o_signals.ready = true;
 }
 
 bool TransactionQueue::remove_WITH_LOCK(h256 const& _txHash)
@@ -229,6 +316,7 @@ bool TransactionQueue::remove_WITH_LOCK(h256 const& _txHash)
     auto it = m_currentByAddressAndNonce.find(from);
     assert (it != m_currentByAddressAndNonce.end());
     it->second.erase((*t->second).transaction.nonce());
+    m_currentBytes -= t->second->size;
     m_current.erase(t->second);
     m_currentByHash.erase(t);
     if (it->second.empty())
@@ -267,6 +355,9 @@ void TransactionQueue::setFuture(h256 const& _txHash)
     {
         VerifiedTransaction& t = const_cast<VerifiedTransaction&>(*(m->second)); // set has only const iterators. Since we are moving out of container that's fine
         m_currentByHash.erase(t.transaction.sha3());
+        m_currentBytes -= t.size;
+        m_futureBytes += t.size;
+        m_futureByPrice.emplace(t.transaction.gasPrice(), from, t.transaction.nonce());
         target.emplace(t.transaction.nonce(), move(t));
         m_current.erase(m->second);
         ++m_futureSize;
@@ -274,9 +365,10 @@ void TransactionQueue::setFuture(h256 const& _txHash)
     queue.erase(cutoff, queue.end());
     if (queue.empty())
         m_currentByAddressAndNonce.erase(from);
+    enforceLimits_WITH_LOCK();
 }
 
-void TransactionQueue::makeCurrent_WITH_LOCK(Transaction const& _t)
+bool TransactionQueue::makeCurrent_WITH_LOCK(Transaction const& _t)
 {
     bool newCurrent = false;
     auto fs = m_future.find(_t.from());
@@ -290,9 +382,12 @@ void TransactionQueue::makeCurrent_WITH_LOCK(Transaction const& _t)
             while (ft != fs->second.end() && ft->second.transaction.nonce() == nonce)
             {
                 auto inserted = m_currentByAddressAndNonce[_t.from()].insert(std::make_pair(ft->second.transaction.nonce(), PriorityQueue::iterator()));
+                m_futureByPrice.erase(std::make_tuple(ft->second.transaction.gasPrice(), _t.from(), nonce));
                 PriorityQueue::iterator handle = m_current.emplace(move(ft->second));
                 inserted.first->second = handle;
                 m_currentByHash[(*handle).transaction.sha3()] = handle;
+                m_futureBytes -= handle->size;
+                m_currentBytes += handle->size;
                 --m_futureSize;
                 ++ft;
                 ++nonce;
@@ -303,21 +398,49 @@ void TransactionQueue::makeCurrent_WITH_LOCK(Transaction const& _t)
                 m_future.erase(_t.from());
         }
     }
+    return newCurrent;
+}
+
+void TransactionQueue::removeFuture_WITH_LOCK(Address const& _from, u256 const& _nonce, bool _withLater)
+{
+    auto fs = m_future.find(_from);
+    if (fs == m_future.end())
+        return;
 
-    while (m_futureSize > m_futureLimit)
+    auto const begin = fs->second.lower_bound(_nonce);
+    auto const end = _withLater || begin == fs->second.end() ? fs->second.end() : std::next(begin);
+    for (auto ft = begin; ft != end; ++ft)
     {
-        // TODO: priority queue for future transactions
-        // For now just drop random chain end
+        Transaction const& t = ft->second.transaction;
+        LOG(m_loggerDetail) << "Dropping future transaction " << t.sha3();
+        m_futureByPrice.erase(std::make_tuple(t.gasPrice(), _from, t.nonce()));
+        m_futureBytes -= ft->second.size;
+        m_known.erase(t.sha3());
         --m_futureSize;
-        LOG(m_loggerDetail) << "Dropping out of bounds future transaction "
-                            << m_future.begin()->second.rbegin()->second.transaction.sha3();
-        m_future.begin()->second.erase(--m_future.begin()->second.end());
-        if (m_future.begin()->second.empty())
-            m_future.erase(m_future.begin());
     }
+    fs->second.erase(begin, end);
+    if (fs->second.empty())
+        m_future.erase(fs);
+}
 
-    if (newCurrent)
-        m_onReady();
+void TransactionQueue::enforceLimits_WITH_LOCK()
+{
+    // The later transactions of the sender cannot become current without the dropped one, so
+    // they go too.
+    while (!m_futureByPrice.empty() &&
+           (m_futureSize > m_limits.future || m_currentBytes + m_futureBytes > m_limits.bytes))
+    {
+        auto const cheapest = *m_futureByPrice.begin();
+        removeFuture_WITH_LOCK(std::get<1>(cheapest), std::get<2>(cheapest), true);
+    }
+
+    while (!m_current.empty() &&
+           (m_current.size() > m_limits.current || m_currentBytes > m_limits.bytes))
+    {
+        h256 const dropped = m_current.rbegin()->transaction.sha3();
+        LOG(m_loggerDetail) << "Dropping out of bounds transaction " << dropped;
+        remove_WITH_LOCK(dropped);
+    }
 }
 
 void TransactionQueue::drop(h256 const& _txHash)
@@ -334,11 +457,16 @@ void TransactionQueue::drop(h256 const& _txHash)
 
 void TransactionQueue::dropGood(Transaction const& _t)
 {
-    WriteGuard l(m_lock);
-    makeCurrent_WITH_LOCK(_t);
-    if (!m_known.count(_t.sha3()))
-        return;
-    remove_WITH_LOCK(_t.sha3());
+    bool newCurrent = false;
+    DEV_WRITE_GUARDED(m_lock)
+    {
+        newCurrent = makeCurrent_WITH_LOCK(_t);
+        if (m_known.count(_t.sha3()))
+            remove_WITH_LOCK(_t.sha3());
+        enforceLimits_WITH_LOCK();
+    }
+    if (newCurrent)
+        m_onReady();
 }
 
 void TransactionQueue::clear()
@@ -350,7 +478,10 @@ void TransactionQueue::clear()
     m_currentByAddressAndNonce.clear();
     m_currentByHash.clear();
     m_future.clear();
+    m_futureByPrice.clear();
     m_futureSize = 0;
+    m_currentBytes = 0;
+    m_futureBytes = 0;
 }
 
 void TransactionQueue::enqueue(RLP const& _data, h512 const& _nodeId)
@@ -379,26 +510,31 @@ void TransactionQueue::verifierBody()
 {
     while (!m_aborting)
     {
-        UnverifiedTransaction work;
+        std::vector<UnverifiedTransaction> work;
 
         {
             unique_lock<Mutex> l(x_queue);
             m_queueReady.wait(l, [&](){ return !m_unverified.empty() || m_aborting; });
             if (m_aborting)
                 return;
-            work = move(m_unverified.front());
-            m_unverified.pop_front();
+            // Share the queue among the verifiers, but take enough to make the batch worth it.
+            size_t const batchSize = std::min(c_maxVerificationBatchSize,
+                std::max<size_t>(1, m_unverified.size() / m_verifierCount));
+            work.reserve(batchSize);
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                work.push_back(move(m_unverified.front()));
+                m_unverified.pop_front();
+            }
         }
 
         try
         {
-            Transaction t(work.transaction, CheckTransaction::Cheap); //Signature will be checked later
-            ImportResult ir = import(t);
-            m_onImport(ir, t.sha3(), work.nodeId);
+            importBatch(work);
         }
         catch (...)
         {
-            // should not happen as exceptions are handled in import.
+            // should not happen as exceptions are handled in importBatch.
             cwarn << "Bad transaction:" << boost::current_exception_diagnostic_information();
         }
     }
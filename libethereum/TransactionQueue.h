@@ -25,6 +25,8 @@
 #include <condition_variable>
 #include <thread>
 #include <deque>
+#include <set>
+#include <tuple>
 #include <libdevcore/Common.h>
 #include <libdevcore/Guards.h>
 #include <libdevcore/Log.h>
@@ -44,13 +46,24 @@ namespace eth
 class TransactionQueue
 {
 public:
-    struct Limits { size_t current; size_t future; };
+    struct Limits
+    {
+        Limits(size_t _current, size_t _future, size_t _bytes = 64 * 1024 * 1024,
+            size_t _perSender = 64)
+          : current(_current), future(_future), bytes(_bytes), perSender(_perSender)
+        {}
+
+        size_t current;    ///< Maximum number of pending transactions.
+        size_t future;     ///< Maximum number of future nonce transactions.
+        size_t bytes;      ///< Maximum size of the RLP of all the transactions queued.
+        size_t perSender;  ///< Maximum number of transactions queued from one sender.
+    };
 
     /// @brief TransactionQueue
     /// @param _limit Maximum number of pending transactions in the queue.
     /// @param _futureLimit Maximum number of future nonce transactions.
-    TransactionQueue(unsigned _limit = 1024, unsigned _futureLimit = 1024);
-    TransactionQueue(Limits const& _l): TransactionQueue(_l.current, _l.future) {}
+    TransactionQueue(unsigned _limit = 1024, unsigned _futureLimit = 1024): TransactionQueue(Limits{_limit, _futureLimit}) {}
+    TransactionQueue(Limits const& _l);
     ~TransactionQueue();
     /// Add transaction to the queue to be verified and imported.
     /// @param _data RLP encoded transaction data.
@@ -87,6 +100,13 @@ public:
     /// @returns A hash set of all transactions in the queue
     h256Hash knownTransactions() const;
 
+    /// @returns true if the transaction is in the queue or was dropped from it.
+    bool isKnown(h256 const& _txHash) const;
+
+    /// Get the RLP of a transaction which is ready to be mined
+    /// @returns the RLP, or empty bytes if the transaction is not in the queue or has a future nonce
+    bytes currentTransactionRLP(h256 const& _txHash) const;
+
     /// Get max nonce for an account
     /// @returns Max transaction nonce for account in the queue
     u256 maxNonce(Address const& _a) const;
@@ -105,12 +125,13 @@ public:
         size_t future;
         size_t unverified;
         size_t dropped;
+        size_t bytes;
     };
     /// @returns the status of the transaction queue.
-    Status status() const { Status ret; DEV_GUARDED(x_queue) { ret.unverified = m_unverified.size(); } ReadGuard l(m_lock); ret.dropped = m_dropped.size(); ret.current = m_currentByHash.size(); ret.future = m_future.size(); return ret; }
+    Status status() const { Status ret; DEV_GUARDED(x_queue) { ret.unverified = m_unverified.size(); } ReadGuard l(m_lock); ret.dropped = m_dropped.size(); ret.current = m_currentByHash.size(); ret.future = m_future.size(); ret.bytes = m_currentBytes + m_futureBytes; return ret; }
 
     /// @returns the transacrtion limits on current/future.
-    Limits limits() const { return Limits{m_limit, m_futureLimit}; }
+    Limits limits() const { return m_limits; }
 
     /// Clear the queue
     void clear();
@@ -129,13 +150,14 @@ private:
     /// Verified and imported transaction
     struct VerifiedTransaction
     {
-        VerifiedTransaction(Transaction const& _t): transaction(_t) {}
-        VerifiedTransaction(VerifiedTransaction&& _t): transaction(std::move(_t.transaction)) {}
+        VerifiedTransaction(Transaction const& _t): transaction(_t), size(_t.rlp().size()) {}
+        VerifiedTransaction(VerifiedTransaction&& _t): transaction(std::move(_t.transaction)), size(_t.size) {}
 
         VerifiedTransaction(VerifiedTransaction const&) = delete;
         VerifiedTransaction& operator=(VerifiedTransaction const&) = delete;
 
         Transaction transaction;  ///< Transaction data
+        size_t size;              ///< Size of the transaction RLP
     };
 
     /// Transaction pending verification
@@ -175,13 +197,33 @@ private:
     // Use a set with dynamic comparator for minmax priority queue. The comparator takes into account min account nonce. Updating it does not affect the order.
     using PriorityQueue = std::multiset<VerifiedTransaction, PriorityCompare>;
 
+    /// Signals raised while m_lock is held, emitted once it is released.
+    struct PendingSignals
+    {
+        bool ready = false;
+        h256s replaced;
+    };
+
     ImportResult import(bytesConstRef _tx, IfDropped _ik = IfDropped::Ignore);
     ImportResult check_WITH_LOCK(h256 const& _h, IfDropped _ik);
-    ImportResult manageImport_WITH_LOCK(h256 const& _h, Transaction const& _transaction);
-
-    void insertCurrent_WITH_LOCK(std::pair<h256, Transaction> const& _p);
-    void makeCurrent_WITH_LOCK(Transaction const& _t);
+    ImportResult manageImport_WITH_LOCK(
+        h256 const& _h, Transaction const& _transaction, PendingSignals& o_signals);
+
+    /// Decodes the transactions of @a _batch and recovers their senders outside of m_lock, then
+    /// imports them all under one acquisition of m_lock.
+    void importBatch(std::vector<UnverifiedTransaction> const& _batch);
+    void emitSignals(PendingSignals const& _signals);
+
+    void insertCurrent_WITH_LOCK(std::pair<h256, Transaction> const& _p, PendingSignals& o_signals);
+    /// Moves the future transactions following @a _t to current.
+    /// @returns true if any transaction was moved.
+    bool makeCurrent_WITH_LOCK(Transaction const& _t);
     bool remove_WITH_LOCK(h256 const& _txHash);
+    /// Drops the future transaction of @a _from with nonce @a _nonce, and the later ones too if
+    /// @a _withLater.
+    void removeFuture_WITH_LOCK(Address const& _from, u256 const& _nonce, bool _withLater);
+    /// Drops the cheapest transactions until the queue is within its limits, future ones first.
+    void enforceLimits_WITH_LOCK();
     u256 maxNonce_WITH_LOCK(Address const& _a) const;
     void verifierBody();
 
@@ -195,15 +237,18 @@ private:
     std::unordered_map<h256, PriorityQueue::iterator> m_currentByHash;			///< Transaction hash to set ref
     std::unordered_map<Address, std::map<u256, PriorityQueue::iterator>> m_currentByAddressAndNonce; ///< Transactions grouped by account and nonce
     std::unordered_map<Address, std::map<u256, VerifiedTransaction>> m_future;	/// Future transactions
+    std::set<std::tuple<u256, Address, u256>> m_futureByPrice;	///< Gas price, sender and nonce of the future transactions, cheapest first
 
     Signal<> m_onReady;															///< Called when a subsequent call to import transactions will return a non-empty container. Be nice and exit fast.
     Signal<ImportResult, h256 const&, h512 const&> m_onImport;					///< Called for each import attempt. Arguments are result, transaction id an node id. Be nice and exit fast.
     Signal<h256 const&> m_onReplaced;											///< Called whan transction is dropped during a call to import() to make room for another transaction.
-    unsigned m_limit;															///< Max number of pending transactions
-    unsigned m_futureLimit;														///< Max number of future transactions
+    Limits const m_limits;
     unsigned m_futureSize = 0;													///< Current number of future transactions
+    size_t m_currentBytes = 0;													///< Size of the RLP of the current transactions
+    size_t m_futureBytes = 0;													///< Size of the RLP of the future transactions
 
     std::condition_variable m_queueReady;										///< Signaled when m_unverified has a new entry.
+    unsigned const m_verifierCount;
     std::vector<std::thread> m_verifiers;
     std::deque<UnverifiedTransaction> m_unverified;  ///< Pending verification queue
     mutable Mutex x_queue;                           ///< Verification queue mutex
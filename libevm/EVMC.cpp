@@ -2,6 +2,7 @@
 // Licensed under the GNU General Public License v3. See the LICENSE file.
 
 #include "EVMC.h"
+#include "EVMCHostExtensions.h"
 
 #include <libdevcore/Log.h>
 #include <libevm/VMFactory.h>
@@ -15,6 +16,9 @@ EVM::EVM(evmc_instance* _instance) noexcept : m_instance(_instance)
     assert(m_instance != nullptr);
     assert(evmc_is_abi_compatible(m_instance));
 
+    // Announce the host extensions. VMs not knowing them just reject the option.
+    evmc_set_option(m_instance, ALETH_HOST_EXTENSIONS_OPTION, ALETH_HOST_EXTENSIONS_VERSION);
+
     // Set the options.
     for (auto& pair : evmcOptions())
     {
@@ -0,0 +1,55 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Extensions of the EVMC host interface that aleth offers to the EVMC VMs asking for them.
+///
+/// Aleth sets the EVMC option ALETH_HOST_EXTENSIONS_OPTION to ALETH_HOST_EXTENSIONS_VERSION on
+/// every VM it loads. A VM accepting the option may assume that the host member of the
+/// evmc_context it executes with points to the evmc member of an aleth_host_interface.
+#pragma once
+
+#include <evmc/evmc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ALETH_HOST_EXTENSIONS_OPTION "aleth-host-extensions"
+#define ALETH_HOST_EXTENSIONS_VERSION "1"
+
+/// The fields of an account the EVM reads, as returned by aleth_get_account_info_fn.
+struct aleth_account_info
+{
+    bool exists;  ///< As reported by evmc_account_exists_fn for the current revision.
+    evmc_uint256be balance;
+    size_t code_size;
+    evmc_bytes32 code_hash;
+};
+
+/// Reads @a count storage values of the account into @a values in one callback.
+typedef void (*aleth_get_storage_batch_fn)(struct evmc_context* context,
+    evmc_address const* address, evmc_bytes32 const* keys, evmc_bytes32* values, size_t count);
+
+/// Reads the existence, balance, code size and code hash of an account in one callback.
+typedef void (*aleth_get_account_info_fn)(
+    struct evmc_context* context, evmc_address const* address, struct aleth_account_info* info);
+
+/// @returns the code of an account without copying it, and its size in @a code_size.
+/// The code stays valid until the next callback to the host.
+typedef uint8_t const* (*aleth_get_code_fn)(
+    struct evmc_context* context, evmc_address const* address, size_t* code_size);
+
+/// The EVMC host interface followed by the aleth extensions.
+struct aleth_host_interface
+{
+    struct evmc_host_interface evmc;
+    aleth_get_storage_batch_fn get_storage_batch;
+    aleth_get_account_info_fn get_account_info;
+    aleth_get_code_fn get_code;
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,6 +16,7 @@
 */
 
 #include "ExtVMFace.h"
+#include "EVMCHostExtensions.h"
 
 #include <evmc/helpers.h>
 
@@ -279,26 +280,66 @@ evmc_result call(evmc_context* _context, evmc_message const* _msg) noexcept
     return evmcResult;
 }
 
-evmc_host_interface const hostInterface = {
-    accountExists,
-    getStorage,
-    setStorage,
-    getBalance,
-    getCodeSize,
-    getCodeHash,
-    copyCode,
-    selfdestruct,
-    eth::call,
-    getTxContext,
-    getBlockHash,
-    eth::log,
+void getStorageBatch(evmc_context* _context, evmc_address const* _addr,
+    evmc_bytes32 const* _keys, evmc_bytes32* _values, size_t _count) noexcept
+{
+    (void)_addr;
+    auto& env = static_cast<ExtVMFace&>(*_context);
+    assert(fromEvmC(*_addr) == env.myAddress);
+    std::vector<u256> keys(_count);
+    for (size_t i = 0; i < _count; ++i)
+        keys[i] = fromEvmC(_keys[i]);
+    std::vector<u256> values(_count);
+    env.storeBatch(keys.data(), values.data(), _count);
+    for (size_t i = 0; i < _count; ++i)
+        _values[i] = toEvmC(values[i]);
+}
+
+void getAccountInfo(
+    evmc_context* _context, evmc_address const* _addr, aleth_account_info* _info) noexcept
+{
+    auto& env = static_cast<ExtVMFace&>(*_context);
+    Address const addr = fromEvmC(*_addr);
+    _info->exists = env.exists(addr);
+    _info->balance = toEvmC(env.balance(addr));
+    _info->code_size = env.codeSizeAt(addr);
+    _info->code_hash = toEvmC(env.codeHashAt(addr));
+}
+
+uint8_t const* getCode(
+    evmc_context* _context, evmc_address const* _addr, size_t* _codeSize) noexcept
+{
+    auto& env = static_cast<ExtVMFace&>(*_context);
+    bytes const& code = env.codeAt(fromEvmC(*_addr));
+    *_codeSize = code.size();
+    return code.data();
+}
+
+aleth_host_interface const hostInterface = {
+    {
+        accountExists,
+        getStorage,
+        setStorage,
+        getBalance,
+        getCodeSize,
+        getCodeHash,
+        copyCode,
+        selfdestruct,
+        eth::call,
+        getTxContext,
+        getBlockHash,
+        eth::log,
+    },
+    getStorageBatch,
+    getAccountInfo,
+    getCode,
 };
 }
 
 ExtVMFace::ExtVMFace(EnvInfo const& _envInfo, Address _myAddress, Address _caller, Address _origin,
     u256 _value, u256 _gasPrice, bytesConstRef _data, bytes _code, h256 const& _codeHash,
     unsigned _depth, bool _isCreate, bool _staticCall)
-  : evmc_context{&hostInterface},
+  : evmc_context{&hostInterface.evmc},
     m_envInfo(_envInfo),
     myAddress(_myAddress),
     caller(_caller),
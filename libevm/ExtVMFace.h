@@ -164,10 +164,20 @@ public:
     LastBlockHashesFace const& lastHashes() const { return m_lastHashes; }
     u256 const& gasUsed() const { return m_gasUsed; }
 
+    /// Sets the gas used by the transactions executed before the current one, so that the
+    /// transactions of a block can share a single EnvInfo.
+    void setGasUsed(u256 const& _gasUsed) { m_gasUsed = _gasUsed; }
+
+    /// @returns the hashes of the blocks preceding the current one, most recent first.
+    /// They are looked up on the first call only.
+    /// @note Defined in libethereum, which owns LastBlockHashesFace.
+    h256s const& precedingHashes() const;
+
 private:
     BlockHeader m_headerInfo;
     LastBlockHashesFace const& m_lastHashes;
     u256 m_gasUsed;
+    mutable h256s m_precedingHashes;
 };
 
 /// Represents a call result.
@@ -216,6 +226,13 @@ public:
     /// Read storage location.
     virtual u256 store(u256) { return 0; }
 
+    /// Read @a _count storage locations at once.
+    virtual void storeBatch(u256 const* _keys, u256* o_values, size_t _count)
+    {
+        for (size_t i = 0; i < _count; ++i)
+            o_values[i] = store(_keys[i]);
+    }
+
     /// Write a value in storage.
     virtual void setStore(u256, u256) {}
 
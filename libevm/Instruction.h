@@ -169,6 +169,12 @@ enum class Instruction : uint8_t
     LOG4,         ///< Makes a log entry; 4 topics.
 
     // these are generated by the interpreter - should never be in user code
+    PUSH1ADD = 0xa5,  ///< PUSH1 followed by ADD - fused
+    PUSH1MSTORE,      ///< PUSH1 followed by MSTORE - fused
+    PUSH1JUMPI,       ///< PUSH1 followed by JUMPI - fused, pre-verified
+    PUSH2JUMPI,       ///< PUSH2 followed by JUMPI - fused, pre-verified
+    DUPSWAP,          ///< DUPn followed by SWAPm - fused
+
     PUSHC = 0xac,  ///< push value from constant pool
     JUMPC,         ///< alter the program counter - pre-verified
     JUMPCI,        ///< conditionally alter the program counter - pre-verified
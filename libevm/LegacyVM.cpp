@@ -222,6 +222,7 @@ owning_bytes_ref LegacyVM::exec(u256& _io_gas, ExtVMFace& _ext, OnOpFunc const&
     m_schedule = &m_ext->evmSchedule();
     m_onOp = _onOp;
     m_onFail = &LegacyVM::onOperation; // this results in operations that fail being logged twice in the trace
+    m_interpretCases = m_onOp ? &LegacyVM::interpretCases<true> : &LegacyVM::interpretCases<false>;
     m_PC = 0;
 
     try
@@ -246,6 +247,7 @@ owning_bytes_ref LegacyVM::exec(u256& _io_gas, ExtVMFace& _ext, OnOpFunc const&
 //
 // main interpreter loop and switch
 //
+template <bool Traced>
 void LegacyVM::interpretCases()
 {
     INIT_CASES
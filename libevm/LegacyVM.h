@@ -107,8 +107,10 @@ private:
     void initEntry();
     void optimize();
 
-    // interpreter loop & switch
+    // interpreter loop & switch, compiled with and without the per-instruction tracing hook
+    template <bool Traced>
     void interpretCases();
+    MemFnPtr m_interpretCases = 0;
 
     // interpreter cases that call out
     void caseCreate();
@@ -117,7 +117,7 @@ int64_t LegacyVM::verifyJumpDest(u256 const& _dest, bool _throw)
 
 void LegacyVM::caseCreate()
 {
-    m_bounce = &LegacyVM::interpretCases;
+    m_bounce = m_interpretCases;
     m_runGas = toInt63(m_schedule->createGas);
 
     // Collect arguments.
@@ -167,7 +167,7 @@ void LegacyVM::caseCreate()
 
 void LegacyVM::caseCall()
 {
-    m_bounce = &LegacyVM::interpretCases;
+    m_bounce = m_interpretCases;
 
     // TODO: Please check if that does not actually increases the stack size.
     //       That was the case before.
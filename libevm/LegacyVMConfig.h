@@ -112,7 +112,8 @@ namespace dev
 #define TRACE_OP(level, pc, op)
 #define TRACE_PRE_OPT(level, pc, op)
 #define TRACE_POST_OPT(level, pc, op)
-#define ON_OP() onOperation()
+// Traced is the template parameter of interpretCases(), so the untraced loop has no hook at all.
+#define ON_OP() (Traced ? onOperation() : void())
 #endif
 
 // Executive swallows exceptions in some circumstances
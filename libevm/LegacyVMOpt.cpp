@@ -193,7 +193,7 @@ void LegacyVM::optimize()
 //
 void LegacyVM::initEntry()
 {
-	m_bounce = &LegacyVM::interpretCases;
+	m_bounce = m_interpretCases;
 	initMetrics();
 	optimize();
 }
@@ -179,6 +179,16 @@ VMPtr VMFactory::create()
     return create(g_kind);
 }
 
+std::string VMFactory::kindName()
+{
+    if (g_kind == VMKind::DLL)
+        return g_evmcDll ? g_evmcDll->name() : "evmc";
+    for (auto const& entry : vmKindsTable)
+        if (entry.kind == g_kind)
+            return entry.name;
+    return {};
+}
+
 VMPtr VMFactory::create(VMKind _kind)
 {
     static const auto default_delete = [](VMFace * _vm) noexcept { delete _vm; };
@@ -54,6 +54,9 @@ public:
 
     /// Creates a VM instance of the kind provided.
     static VMPtr create(VMKind _kind);
+
+    /// @returns the name of the global kind, or of the EVMC VM loaded for it.
+    static std::string kindName();
 };
 }  // namespace eth
 }  // namespace dev
@@ -0,0 +1,98 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "HandshakeWorkers.h"
+
+#include <libdevcore/Log.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::p2p;
+
+HandshakeWorkers::HandshakeWorkers(unsigned _threads, size_t _maxQueued)
+  : m_work(new ba::io_service::work(m_service)), m_maxQueued(_maxQueued)
+{
+    for (unsigned i = 0; i < _threads; ++i)
+        m_threads.emplace_back([=]() {
+            setThreadName("handshake" + toString(i));
+            m_service.run();
+        });
+}
+
+HandshakeWorkers::~HandshakeWorkers()
+{
+    // Jobs still queued are dropped, which releases the handshakes they hold.
+    m_work.reset();
+    m_service.stop();
+    for (auto& t : m_threads)
+        t.join();
+}
+
+unsigned HandshakeWorkers::defaultThreads()
+{
+    return max(1U, min(4U, thread::hardware_concurrency() / 2));
+}
+
+bool HandshakeWorkers::post(function<void()> _job)
+{
+    if (++m_queued > m_maxQueued)
+    {
+        --m_queued;
+        return false;
+    }
+    m_service.post([this, _job]() {
+        try
+        {
+            _job();
+        }
+        catch (std::exception const& _e)
+        {
+            cnetlog << "Handshake job failed: " << _e.what();
+        }
+        --m_queued;
+    });
+    return true;
+}
+
+ConnectionRateLimiter::ConnectionRateLimiter(
+    unsigned _burst, unsigned _perMinute, size_t _maxAddresses)
+  : m_burst(_burst), m_perSecond(_perMinute / 60.0), m_maxAddresses(_maxAddresses)
+{}
+
+bool ConnectionRateLimiter::admit(bi::address const& _address, chrono::steady_clock::time_point _now)
+{
+    auto it = m_buckets.find(_address);
+    if (it == m_buckets.end())
+    {
+        if (m_buckets.size() >= m_maxAddresses)
+            prune(_now);
+        it = m_buckets.insert(make_pair(_address, Bucket{m_burst, _now})).first;
+    }
+    else
+        refill(it->second, _now);
+
+    if (it->second.tokens < 1)
+        return false;
+    it->second.tokens -= 1;
+    return true;
+}
+
+void ConnectionRateLimiter::refill(Bucket& _bucket, chrono::steady_clock::time_point _now) const
+{
+    double const seconds = chrono::duration<double>(_now - _bucket.updated).count();
+    _bucket.tokens = min(m_burst, _bucket.tokens + seconds * m_perSecond);
+    _bucket.updated = _now;
+}
+
+void ConnectionRateLimiter::prune(chrono::steady_clock::time_point _now)
+{
+    for (auto it = m_buckets.begin(); it != m_buckets.end();)
+    {
+        refill(it->second, _now);
+        if (it->second.tokens >= m_burst)
+            it = m_buckets.erase(it);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,92 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Threads running the public key cryptography of RLPx handshakes, and admission of incoming
+/// connections.
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+namespace p2p
+{
+/**
+ * @brief Runs handshake jobs on a fixed set of threads, so that the ECIES, ECDH and signature
+ * recovery of new connections don't delay the IO of the established sessions.
+ *
+ * At most a given number of jobs are queued; further jobs are rejected and the caller is expected
+ * to drop the connection.
+ * @threadsafe
+ */
+class HandshakeWorkers
+{
+public:
+    HandshakeWorkers(unsigned _threads, size_t _maxQueued);
+    ~HandshakeWorkers();
+
+    HandshakeWorkers(HandshakeWorkers const&) = delete;
+    HandshakeWorkers& operator=(HandshakeWorkers const&) = delete;
+
+    /// @returns the number of threads suited to this machine.
+    static unsigned defaultThreads();
+
+    /// Queues @a _job. @returns false if too many jobs are queued already.
+    bool post(std::function<void()> _job);
+
+    /// @returns the number of jobs queued or running.
+    size_t queued() const { return m_queued; }
+
+private:
+    ba::io_service m_service;
+    std::unique_ptr<ba::io_service::work> m_work;  ///< Keeps the threads waiting for jobs.
+    std::vector<std::thread> m_threads;
+    size_t const m_maxQueued;
+    std::atomic<size_t> m_queued = {0};
+};
+
+/**
+ * @brief Limits the rate of incoming connections from each IP address.
+ *
+ * Each address has a bucket of @a _burst connections, refilled at @a _perMinute connections per
+ * minute. Addresses whose bucket is full are forgotten when too many addresses are known.
+ * Not thread-safe; used only on the network thread.
+ */
+class ConnectionRateLimiter
+{
+public:
+    ConnectionRateLimiter(unsigned _burst, unsigned _perMinute, size_t _maxAddresses = 4096);
+
+    /// Takes a connection from the bucket of @a _address. @returns false if it is empty.
+    bool admit(bi::address const& _address,
+        std::chrono::steady_clock::time_point _now = std::chrono::steady_clock::now());
+
+private:
+    struct Bucket
+    {
+        double tokens;
+        std::chrono::steady_clock::time_point updated;
+    };
+
+    /// Adds the connections accumulated since the last update of @a _bucket.
+    void refill(Bucket& _bucket, std::chrono::steady_clock::time_point _now) const;
+    void prune(std::chrono::steady_clock::time_point _now);
+
+    double const m_burst;
+    double const m_perSecond;
+    size_t const m_maxAddresses;
+    std::map<bi::address, Bucket> m_buckets;
+};
+
+}  // namespace p2p
+}  // namespace dev
@@ -44,6 +44,16 @@ std::chrono::seconds const c_keepAliveInterval = std::chrono::seconds(30);
 /// Disconnect timeout after failure to respond to keepAlivePeers ping.
 std::chrono::milliseconds const c_keepAliveTimeOut = std::chrono::milliseconds(1000);
 
+/// Maximum number of handshakes in progress; further incoming connections are dropped.
+size_t const c_maxPendingHandshakes = 256;
+
+/// Maximum number of handshake crypto jobs waiting for a worker.
+size_t const c_maxQueuedHandshakeJobs = 512;
+
+/// Incoming connections allowed from one IP address at once, and per minute afterwards.
+unsigned const c_connectionBurstPerIP = 8;
+unsigned const c_connectionsPerIPPerMinute = 30;
+
 HostNodeTableHandler::HostNodeTableHandler(Host& _host): m_host(_host) {}
 
 void HostNodeTableHandler::processEvent(NodeID const& _n, NodeTableEventType const& _e)
@@ -102,6 +112,8 @@ Host::Host(string const& _clientVersion, KeyPair const& _alias, NetworkConfig co
     m_ioService(2),
     m_tcp4Acceptor(m_ioService),
     m_alias(_alias),
+    m_handshakeWorkers(new HandshakeWorkers(HandshakeWorkers::defaultThreads(), c_maxQueuedHandshakeJobs)),
+    m_connectionRateLimiter(c_connectionBurstPerIP, c_connectionsPerIPPerMinute),
     m_lastPing(chrono::steady_clock::time_point::min()),
     m_capabilityHost(createCapabilityHost(*this))
 {
@@ -178,8 +190,8 @@ void Host::doneWorking()
         m_ioService.poll();
 
     // stop capabilities (eth: stops syncing or block/tx broadcast)
-    for (auto const& h: m_capabilities)
-        h.second->onStopping();
+    for (auto const& h: uniqueCapabilities())
+        h->onStopping();
 
     // disconnect pending handshake, before peers, as a handshake may create a peer
     for (unsigned n = 0;; n = 0)
@@ -348,10 +360,25 @@ void Host::startPeerSession(Public const& _id, RLP const& _rlp, unique_ptr<RLPXF
 
         session->start();
     }
-    
+
+    if (m_nodeDB)
+    {
+        NodeIPEndpoint endpoint = peer->endpoint;
+        if (!endpoint.tcpPort())
+            endpoint.setTcpPort(listenPort);
+        if (endpoint.tcpPort())
+            m_nodeDB->noteSession(_id, endpoint, caps);
+    }
+
     LOG(m_logger) << "p2p.host.peer.register " << _id;
 }
 
+void Host::onPeerPong(NodeID const& _id, chrono::steady_clock::duration _latency)
+{
+    if (m_nodeDB)
+        m_nodeDB->notePong(_id, _latency);
+}
+
 void Host::onNodeTableEvent(NodeID const& _n, NodeTableEventType const& _e)
 {
     if (_e == NodeEntryAdded)
@@ -463,7 +490,26 @@ void Host::runAcceptor()
                     runAcceptor();
                 return;
             }
-            
+
+            // Admission is decided before any crypto is done, so that a flood of connections
+            // costs us no more than accepting and closing them.
+            if (!m_connectionRateLimiter.admit(socket->remoteEndpoint().address()))
+            {
+                cnetdetails << "Dropping incoming connect from " << socket->remoteEndpoint()
+                            << ": too many connections from this address";
+                socket->close();
+                runAcceptor();
+                return;
+            }
+            if (pendingHandshakes() >= c_maxPendingHandshakes)
+            {
+                cnetdetails << "Dropping incoming connect from " << socket->remoteEndpoint()
+                            << ": too many handshakes in progress";
+                socket->close();
+                runAcceptor();
+                return;
+            }
+
             bool success = false;
             try
             {
@@ -506,6 +552,15 @@ std::unordered_map<Public, std::string> Host::pocHosts()
     };
 }
 
+vector<shared_ptr<CapabilityFace>> Host::uniqueCapabilities() const
+{
+    vector<shared_ptr<CapabilityFace>> ret;
+    for (auto const& c: m_capabilities)
+        if (find(ret.begin(), ret.end(), c.second) == ret.end())
+            ret.push_back(c.second);
+    return ret;
+}
+
 void Host::registerCapability(std::shared_ptr<CapabilityFace> const& _cap)
 {
     registerCapability(_cap, _cap->name(), _cap->version());
@@ -546,6 +601,13 @@ void Host::addNode(NodeID const& _node, NodeIPEndpoint const& _endpoint)
     addNodeToNodeTable(Node(_node, _endpoint));
 }
 
+size_t Host::pendingHandshakes()
+{
+    Guard l(x_connecting);
+    return count_if(m_connecting.begin(), m_connecting.end(),
+        [](weak_ptr<RLPXHandshake> const& _h) { return !_h.expired(); });
+}
+
 void Host::requirePeer(NodeID const& _n, NodeIPEndpoint const& _endpoint)
 {
     {
@@ -772,8 +834,8 @@ void Host::startedWorking()
     }
 
     // start capability threads (ready for incoming connections)
-    for (auto const& h: m_capabilities)
-        h.second->onStarting();
+    for (auto const& h: uniqueCapabilities())
+        h->onStarting();
     
     // try to open acceptor (todo: ipv6)
     int port = Network::tcp4Listen(m_tcp4Acceptor, m_netConfig);
@@ -795,7 +857,11 @@ void Host::startedWorking()
     nodeTable->setEventHandler(new HostNodeTableHandler(*this));
     DEV_GUARDED(x_nodeTable)
         m_nodeTable = nodeTable;
+
+    if (!m_nodeDB && !m_netConfig.nodeDBPath.empty())
+        m_nodeDB.reset(new NodeDB(m_netConfig.nodeDBPath));
     restoreNetwork(&m_restoreNetwork);
+    connectToKnownNodes();
 
     LOG(m_logger) << "p2p.started id: " << id();
 
@@ -982,6 +1048,43 @@ void Host::restoreNetwork(bytesConstRef _b)
     }
 }
 
+void Host::connectToKnownNodes()
+{
+    if (!m_nodeDB || m_dropPeers)
+        return;
+
+    // Nodes not seen for longer are likely to have changed their address or gone away.
+    chrono::hours const maxAge{24 * 7};
+    unsigned dialed = 0;
+    for (NodeRecord const& record : m_nodeDB->bestNodes(m_idealPeerCount * 2, maxAge))
+    {
+        if (record.id == id() || !record.endpoint.isAllowed())
+            continue;
+
+        shared_ptr<Peer> p;
+        DEV_RECURSIVE_GUARDED(x_sessions)
+        {
+            auto it = m_peers.find(record.id);
+            if (it != m_peers.end())
+                p = it->second;
+            else
+            {
+                p = make_shared<Peer>(Node(record.id, record.endpoint));
+                p->m_lastConnected = record.lastSession;
+                m_peers[record.id] = p;
+            }
+        }
+        if (p->peerType == PeerType::Required)
+            continue;
+
+        // Known nodes skip the discovery ping, so that they can be dialed right away.
+        addNodeToNodeTable(*p, NodeTable::NodeRelation::Known);
+        connect(p);
+        ++dialed;
+    }
+    cnetdetails << "Dialed " << dialed << " of " << m_nodeDB->size() << " nodes of the node DB";
+}
+
 bool Host::peerSlotsAvailable(Host::PeerSlotType _type /*= Ingress*/)
 {
     return peerCount() + m_pendingPeerConns.size() < peerSlots(_type);
@@ -18,7 +18,9 @@
 #pragma once
 
 #include "Common.h"
+#include "HandshakeWorkers.h"
 #include "Network.h"
+#include "NodeDB.h"
 #include "NodeTable.h"
 #include "Peer.h"
 #include "RLPXFrameCoder.h"
@@ -220,6 +222,9 @@ public:
     /// @returns if network is started and interactive.
     bool haveNetwork() const { Guard l(x_runTimer); Guard ll(x_nodeTable); return m_run && !!m_nodeTable; }
     
+    /// Records the latency of a ping answered by a peer in the node DB.
+    void onPeerPong(NodeID const& _id, std::chrono::steady_clock::duration _latency);
+
     /// Validates and starts peer session, taking ownership of _io. Disconnects and returns false upon error.
     void startPeerSession(Public const& _id, RLP const& _hello, std::unique_ptr<RLPXFrameCoder>&& _io, std::shared_ptr<RLPXSocket> const& _s);
 
@@ -301,6 +306,15 @@ private:
     Node nodeFromNodeTable(Public const& _id) const;
     bool addNodeToNodeTable(Node const& _node, NodeTable::NodeRelation _relation = NodeTable::NodeRelation::Unknown);
 
+    /// @returns the number of handshakes in progress, incoming and outgoing.
+    size_t pendingHandshakes();
+
+    /// @returns each of the capabilities once, even those registered for several versions.
+    std::vector<std::shared_ptr<CapabilityFace>> uniqueCapabilities() const;
+
+    /// Dials the nodes of the node DB we had the best sessions with. Called only from startedWorking().
+    void connectToKnownNodes();
+
     bytes m_restoreNetwork;										///< Set by constructor and used to set Host key and restore network peers & nodes.
 
     std::atomic<bool> m_run{false};													///< Whether network is running.
@@ -345,6 +359,9 @@ private:
     std::list<std::weak_ptr<RLPXHandshake>> m_connecting;					///< Pending connections.
     Mutex x_connecting;													///< Mutex for m_connecting.
 
+    std::unique_ptr<HandshakeWorkers> m_handshakeWorkers;					///< Threads running the crypto of handshakes.
+    ConnectionRateLimiter m_connectionRateLimiter;						///< Per-IP limit of incoming connections.
+
     unsigned m_idealPeerCount = 11;										///< Ideal number of peers to be connected to.
     unsigned m_stretchPeers = 7;										///< Accepted connection multiplier (max peers = ideal*stretch).
 
@@ -361,6 +378,8 @@ private:
 
     ReputationManager m_repMan;
 
+    std::unique_ptr<NodeDB> m_nodeDB;										///< Nodes we had sessions with; null if disabled.
+
     std::shared_ptr<CapabilityHostFace> m_capabilityHost;
 
     Logger m_logger{createLogger(VerbosityDebug, "net")};
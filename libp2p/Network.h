@@ -28,6 +28,7 @@
 #include <array>
 #include <libdevcore/RLP.h>
 #include <libdevcore/Guards.h>
+#include <boost/filesystem/path.hpp>
 #include "Common.h"
 namespace ba = boost::asio;
 namespace bi = ba::ip;
@@ -62,6 +63,7 @@ struct NetworkConfig
 	bool traverseNAT = true;
 	bool discovery = true;		// Discovery is activated with network.
 	bool pin = false;			// Only accept or connect to trusted peers.
+	boost::filesystem::path nodeDBPath;	// Nodes we had sessions with, reconnected to on startup. Disabled if empty.
 };
 
 /**
@@ -0,0 +1,190 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "NodeDB.h"
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace dev::p2p;
+namespace fs = boost::filesystem;
+
+namespace
+{
+/// Pongs are written at most this often per node, as they come every keep-alive interval.
+chrono::minutes const c_pongWriteInterval{10};
+
+/// The file is compacted once it holds this many times more records than there are nodes.
+size_t const c_compactionRatio = 4;
+size_t const c_minRecordsBeforeCompaction = 1024;
+
+uint64_t toSeconds(chrono::system_clock::time_point _time)
+{
+    return static_cast<uint64_t>(
+        chrono::duration_cast<chrono::seconds>(_time.time_since_epoch()).count());
+}
+
+bytes toRLP(NodeRecord const& _r)
+{
+    RLPStream s(6);
+    s << _r.id;
+    _r.endpoint.streamRLP(s, NodeIPEndpoint::StreamList);
+    s << toSeconds(_r.lastSession) << toSeconds(_r.lastPong)
+      << static_cast<uint64_t>(_r.latency.count()) << _r.capabilities;
+    return s.out();
+}
+
+NodeRecord fromRLP(RLP const& _r)
+{
+    NodeRecord ret;
+    ret.id = _r[0].toHash<NodeID>();
+    ret.endpoint = NodeIPEndpoint(_r[1]);
+    ret.lastSession = chrono::system_clock::time_point(chrono::seconds(_r[2].toInt<uint64_t>()));
+    ret.lastPong = chrono::system_clock::time_point(chrono::seconds(_r[3].toInt<uint64_t>()));
+    ret.latency = chrono::microseconds(_r[4].toInt<uint64_t>());
+    ret.capabilities = _r[5].toVector<CapDesc>();
+    return ret;
+}
+}  // namespace
+
+NodeDB::NodeDB(fs::path const& _path) : m_path(_path)
+{
+    Guard l(x_records);
+    load();
+    if (m_logRecords > max(c_minRecordsBeforeCompaction, m_records.size()))
+        compact_WITH_LOCK();
+    else
+        m_log.open(m_path, ios::binary | ios::app);
+
+    if (!m_log)
+        cnetnote << "Cannot write the node database " << m_path.string();
+}
+
+void NodeDB::load()
+{
+    bytes const data = contents(m_path);
+    bytesConstRef remaining(&data);
+    while (!remaining.empty())
+    {
+        try
+        {
+            size_t const size = RLP(remaining, RLP::ThrowOnFail | RLP::FailIfTooSmall).actualSize();
+            NodeRecord record = fromRLP(RLP(remaining.cropped(0, size)));
+            m_records[record.id] = move(record);
+            remaining = remaining.cropped(size);
+            ++m_logRecords;
+        }
+        catch (Exception const&)
+        {
+            // The last write was interrupted; it is dropped by the next compaction.
+            cnetlog << "Ignoring " << remaining.size() << " bytes at the end of the node database";
+            m_logRecords = numeric_limits<size_t>::max();
+            break;
+        }
+    }
+}
+
+void NodeDB::noteSession(NodeID const& _id, NodeIPEndpoint const& _endpoint, CapDescs const& _caps)
+{
+    Guard l(x_records);
+    NodeRecord& record = m_records[_id];
+    record.id = _id;
+    record.endpoint = _endpoint;
+    record.lastSession = chrono::system_clock::now();
+    record.capabilities = _caps;
+    append_WITH_LOCK(record);
+}
+
+void NodeDB::notePong(NodeID const& _id, chrono::steady_clock::duration _latency)
+{
+    Guard l(x_records);
+    auto it = m_records.find(_id);
+    if (it == m_records.end())
+        return;
+
+    NodeRecord& record = it->second;
+    auto const now = chrono::system_clock::now();
+    bool const write = now - record.lastPong > c_pongWriteInterval;
+    record.lastPong = now;
+    record.latency = chrono::duration_cast<chrono::microseconds>(_latency);
+    if (write)
+        append_WITH_LOCK(record);
+}
+
+vector<NodeRecord> NodeDB::bestNodes(size_t _max, chrono::seconds _maxAge) const
+{
+    auto const since = chrono::system_clock::now() - _maxAge;
+    vector<NodeRecord> ret;
+    DEV_GUARDED(x_records)
+        for (auto const& r : m_records)
+            if (r.second.lastSession >= since)
+                ret.push_back(r.second);
+
+    // Nodes that never answered a ping go last.
+    auto const rank = [](NodeRecord const& _r) {
+        return _r.lastPong != chrono::system_clock::time_point() ? _r.latency :
+                                                                  chrono::microseconds::max();
+    };
+    sort(ret.begin(), ret.end(), [&](NodeRecord const& _a, NodeRecord const& _b) {
+        return rank(_a) < rank(_b) || (rank(_a) == rank(_b) && _a.lastSession > _b.lastSession);
+    });
+    if (ret.size() > _max)
+        ret.resize(_max);
+    return ret;
+}
+
+NodeRecord NodeDB::node(NodeID const& _id) const
+{
+    Guard l(x_records);
+    auto it = m_records.find(_id);
+    return it != m_records.end() ? it->second : NodeRecord();
+}
+
+size_t NodeDB::size() const
+{
+    Guard l(x_records);
+    return m_records.size();
+}
+
+void NodeDB::append_WITH_LOCK(NodeRecord const& _record)
+{
+    if (m_logRecords >= max(c_minRecordsBeforeCompaction, m_records.size() * c_compactionRatio))
+    {
+        compact_WITH_LOCK();
+        return;
+    }
+
+    bytes const rlp = toRLP(_record);
+    m_log.write(reinterpret_cast<char const*>(rlp.data()), rlp.size());
+    m_log.flush();
+    ++m_logRecords;
+}
+
+void NodeDB::compact_WITH_LOCK()
+{
+    bytes data;
+    for (auto const& r : m_records)
+    {
+        bytes const rlp = toRLP(r.second);
+        data.insert(data.end(), rlp.begin(), rlp.end());
+    }
+
+    if (m_log.is_open())
+        m_log.close();
+    try
+    {
+        writeFile(m_path, data, true);
+    }
+    catch (Exception const& _e)
+    {
+        cnetnote << "Cannot write the node database " << m_path.string() << ": " << _e.what();
+    }
+    m_logRecords = m_records.size();
+    m_log.open(m_path, ios::binary | ios::app);
+}
@@ -0,0 +1,81 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Persistent record of the nodes we had sessions with, used to reconnect quickly on startup.
+#pragma once
+
+#include "Common.h"
+
+#include <libdevcore/Guards.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+namespace dev
+{
+namespace p2p
+{
+struct NodeRecord
+{
+    NodeID id;
+    NodeIPEndpoint endpoint;
+    std::chrono::system_clock::time_point lastSession;  ///< When the last session started.
+    std::chrono::system_clock::time_point lastPong;     ///< When the node last answered a ping,
+                                                        ///< the epoch if it never did.
+    std::chrono::microseconds latency{0};               ///< Round trip of the last ping.
+    CapDescs capabilities;                              ///< Capabilities of the last session.
+};
+
+/**
+ * @brief Keeps a NodeRecord per node in a file.
+ *
+ * Every update is appended to the file as one RLP item, so that nothing is lost when the client
+ * is not shut down cleanly. The file is rewritten with only the latest record of each node when
+ * it holds too many superseded ones.
+ * @threadsafe
+ */
+class NodeDB
+{
+public:
+    /// Opens the DB at @a _path, creating it if it doesn't exist.
+    explicit NodeDB(boost::filesystem::path const& _path);
+
+    NodeDB(NodeDB const&) = delete;
+    NodeDB& operator=(NodeDB const&) = delete;
+
+    /// Records a session started with the node at @a _endpoint.
+    void noteSession(NodeID const& _id, NodeIPEndpoint const& _endpoint, CapDescs const& _caps);
+
+    /// Records a ping answered by a node we had a session with.
+    void notePong(NodeID const& _id, std::chrono::steady_clock::duration _latency);
+
+    /// @returns up to @a _max nodes we had a session with in the last @a _maxAge, lowest latency
+    /// first.
+    std::vector<NodeRecord> bestNodes(size_t _max, std::chrono::seconds _maxAge) const;
+
+    /// @returns the record of @a _id, or a record with a null id if there is none.
+    NodeRecord node(NodeID const& _id) const;
+
+    size_t size() const;
+
+private:
+    void load();
+    void append_WITH_LOCK(NodeRecord const& _record);
+    void compact_WITH_LOCK();
+
+    boost::filesystem::path const m_path;
+
+    mutable Mutex x_records;
+    std::unordered_map<NodeID, NodeRecord> m_records;
+    boost::filesystem::ofstream m_log;
+    size_t m_logRecords = 0;  ///< Number of records in the file, including the superseded ones.
+};
+
+}  // namespace p2p
+}  // namespace dev
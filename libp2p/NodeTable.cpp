@@ -40,11 +40,12 @@ inline bool operator==(
     return !_weak.owner_before(_shared) && !_shared.owner_before(_weak);
 }
 
-NodeEntry::NodeEntry(NodeID const& _src, Public const& _pubk, NodeIPEndpoint const& _gw): Node(_pubk, _gw), distance(NodeTable::distance(_src, _pubk)) {}
+NodeEntry::NodeEntry(NodeID const& _src, Public const& _pubk, NodeIPEndpoint const& _gw): Node(_pubk, _gw), hash(sha3(_pubk)), distance(NodeTable::distance(sha3(_src), hash)) {}
 
 NodeTable::NodeTable(
     ba::io_service& _io, KeyPair const& _alias, NodeIPEndpoint const& _endpoint, bool _enabled)
   : m_hostNode(Node(_alias.pub(), _endpoint)),
+    m_hostNodeHash(sha3(m_hostNode.id)),
     m_secret(_alias.secret()),
     m_socket(make_shared<NodeSocket>(
         _io, *reinterpret_cast<UDPSocketEvents*>(this), (bi::udp::endpoint)m_hostNode.endpoint)),
@@ -216,57 +217,57 @@ void NodeTable::doDiscover(NodeID _node, unsigned _round, shared_ptr<set<shared_
     });
 }
 
-vector<shared_ptr<NodeEntry>> NodeTable::nearestNodeEntries(NodeID _target)
+int NodeTable::distance(h256 const& _a, h256 const& _b)
 {
-    // send s_alpha FindNode packets to nodes we know, closest to target
-    static unsigned lastBin = s_bins - 1;
-    unsigned head = distance(m_hostNode.id, _target);
-    unsigned tail = head == 0 ? lastBin : (head - 1) % s_bins;
-    
-    map<unsigned, list<shared_ptr<NodeEntry>>> found;
-    
-    // if d is 0, then we roll look forward, if last, we reverse, else, spread from d
-    if (head > 1 && tail != lastBin)
-        while (head != tail && head < s_bins)
+    // Index of the highest bit set in _a ^ _b.
+    for (unsigned i = 0; i < h256::size; ++i)
+        if (byte x = _a[i] ^ _b[i])
         {
-            Guard l(x_state);
-            for (auto const& n : m_buckets[head].nodes)
-                if (auto p = n.lock())
-                    found[distance(_target, p->id)].push_back(p);
-
-            if (tail)
-                for (auto const& n : m_buckets[tail].nodes)
-                    if (auto p = n.lock())
-                        found[distance(_target, p->id)].push_back(p);
-
-            head++;
-            if (tail)
-                tail--;
+            int ret = (h256::size - 1 - i) * 8;
+            while (x >>= 1)
+                ++ret;
+            return ret;
         }
-    else if (head < 2)
-        while (head < s_bins)
-        {
-            Guard l(x_state);
-            for (auto const& n : m_buckets[head].nodes)
-                if (auto p = n.lock())
-                    found[distance(_target, p->id)].push_back(p);
-            head++;
-        }
-    else
-        while (tail > 0)
-        {
-            Guard l(x_state);
-            for (auto const& n : m_buckets[tail].nodes)
-                if (auto p = n.lock())
-                    found[distance(_target, p->id)].push_back(p);
-            tail--;
-        }
-    
+    return 0;
+}
+
+vector<shared_ptr<NodeEntry>> NodeTable::nearestNodeEntries(NodeID _target)
+{
+    h256 const target = sha3(_target);
+
+    // Nodes of bucket d are at distance d + 1 from us. The nodes of the bucket of the target are
+    // the closest to it, then come those of the buckets below, which are all at the distance of
+    // the target from us, then those of each bucket above, at their own distance. Buckets are
+    // visited in that order until enough nodes are found, and only those are sorted.
+    int const head = max(distance(m_hostNodeHash, target) - 1, 0);
+    vector<pair<h256, shared_ptr<NodeEntry>>> found;
+    auto const collect = [&](NodeBucket const& _bucket) {
+        for (auto const& n : _bucket.nodes)
+            if (auto p = n.lock())
+                if (!!p->endpoint && p->endpoint.isAllowed())
+                    found.push_back(make_pair(p->hash ^ target, p));
+    };
+
+    DEV_GUARDED(x_state)
+    {
+        collect(m_buckets[head]);
+        if (found.size() < s_bucketSize)
+            for (int d = head - 1; d >= 0; --d)
+                collect(m_buckets[d]);
+        for (unsigned d = head + 1; d < s_bins && found.size() < s_bucketSize; ++d)
+            collect(m_buckets[d]);
+    }
+
+    auto const last = found.begin() + min<size_t>(found.size(), s_bucketSize);
+    partial_sort(found.begin(), last, found.end(),
+        [](pair<h256, shared_ptr<NodeEntry>> const& _a, pair<h256, shared_ptr<NodeEntry>> const& _b) {
+            return _a.first < _b.first;
+        });
+
     vector<shared_ptr<NodeEntry>> ret;
-    for (auto& nodes: found)
-        for (auto const& n: nodes.second)
-            if (ret.size() < s_bucketSize && !!n->endpoint && n->endpoint.isAllowed())
-                ret.push_back(n);
+    ret.reserve(last - found.begin());
+    for (auto it = found.begin(); it != last; ++it)
+        ret.push_back(it->second);
     return ret;
 }
 
@@ -325,7 +326,7 @@ void NodeTable::noteActiveNode(Public const& _pubk, bi::udp::endpoint const& _en
             if (it != nodes.end())
             {
                 // if it was in the bucket, move it to the last position
-                nodes.splice(nodes.end(), nodes, it);
+                rotate(it, it + 1, nodes.end());
             }
             else
             {
@@ -345,7 +346,7 @@ void NodeTable::noteActiveNode(Public const& _pubk, bi::udp::endpoint const& _en
                     // If so, just add a new one instead of expired
                     if (!nodeToEvict)
                     {
-                        nodes.pop_front();
+                        nodes.erase(nodes.begin());
                         nodes.push_back(newNode);
                         if (m_nodeEventHandler)
                             m_nodeEventHandler->appendEvent(newNode->id, NodeEntryAdded);
@@ -365,8 +366,9 @@ void NodeTable::dropNode(shared_ptr<NodeEntry> _n)
     {
         Guard l(x_state);
         NodeBucket& s = bucket_UNSAFE(_n.get());
-        s.nodes.remove_if(
-            [_n](weak_ptr<NodeEntry> const& _bucketEntry) { return _bucketEntry == _n; });
+        s.nodes.erase(remove_if(s.nodes.begin(), s.nodes.end(),
+                          [_n](weak_ptr<NodeEntry> const& _bucketEntry) { return _bucketEntry == _n; }),
+            s.nodes.end());
     }
 
     DEV_GUARDED(x_nodes) { m_allNodes.erase(_n->id); }
@@ -40,6 +40,7 @@ namespace p2p
 struct NodeEntry: public Node
 {
     NodeEntry(NodeID const& _src, Public const& _pubk, NodeIPEndpoint const& _gw);
+    h256 const hash;	///< sha3 of the node id, which the xor metric is computed on.
     int const distance;	///< Node's distance (xor of _src as integer).
     bool pending = true;		///< Node will be ignored until Pong is received
 };
@@ -146,7 +147,10 @@ public:
     ~NodeTable();
 
     /// Returns distance based on xor metric two node ids. Used by NodeEntry and NodeTable.
-    static int distance(NodeID const& _a, NodeID const& _b) { u256 d = sha3(_a) ^ sha3(_b); unsigned ret; for (ret = 0; d >>= 1; ++ret) {}; return ret; }
+    static int distance(NodeID const& _a, NodeID const& _b) { return distance(sha3(_a), sha3(_b)); }
+
+    /// Returns distance based on xor metric of the hashes of two node ids.
+    static int distance(h256 const& _a, h256 const& _b);
 
     /// Set event handler for NodeEntryAdded and NodeEntryDropped events.
     void setEventHandler(NodeTableEventHandler* _handler) { m_nodeEventHandler.reset(_handler); }
@@ -204,7 +208,7 @@ private:
     struct NodeBucket
     {
         unsigned distance;
-        std::list<std::weak_ptr<NodeEntry>> nodes;
+        std::vector<std::weak_ptr<NodeEntry>> nodes;	///< Least recently seen first; at most s_bucketSize.
     };
 
     /// Used to ping endpoint. Used by node table when refreshing buckets and as part of eviction process (see evict).
@@ -223,7 +227,8 @@ private:
     /// Sends s_alpha concurrent requests to nodes nearest to target, for nodes nearest to target, up to s_maxSteps rounds.
     void doDiscover(NodeID _target, unsigned _round = 0, std::shared_ptr<std::set<std::shared_ptr<NodeEntry>>> _tried = std::shared_ptr<std::set<std::shared_ptr<NodeEntry>>>());
 
-    /// Returns nodes from node table which are closest to target.
+    /// Returns up to s_bucketSize nodes from node table which are closest to target, closest first.
+    /// Only the buckets which may hold them are visited.
     std::vector<std::shared_ptr<NodeEntry>> nearestNodeEntries(NodeID _target);
 
     /// Asynchronously drops _leastSeen node if it doesn't reply and adds _new node, otherwise _new node is thrown away.
@@ -261,6 +266,7 @@ private:
 
     /// This node. LOCK x_state if endpoint access or mutation is required. Do not modify id.
     Node m_hostNode;
+    h256 const m_hostNodeHash;										///< sha3 of our id, see NodeEntry::hash.
     Secret m_secret;												///< This nodes secret key.
 
     mutable Mutex x_nodes;											///< LOCK x_state first if both locks are required. Mutable for thread-safe copy in nodes() const.
@@ -37,20 +37,23 @@ void RLPXHandshake::writeAuth()
     bytesRef pubk(&m_auth[Signature::size + h256::size], Public::size);
     bytesRef nonce(&m_auth[Signature::size + h256::size + Public::size], h256::size);
     
-    // E(remote-pubk, S(ecdhe-random, ecdh-shared-secret^nonce) || H(ecdhe-random-pubk) || pubk || nonce || 0x0)
-    Secret staticShared;
-    crypto::ecdh::agree(m_host->m_alias.secret(), m_remote, staticShared);
-    sign(m_ecdheLocal.secret(), staticShared.makeInsecure() ^ m_nonce).ref().copyTo(sig);
-    sha3(m_ecdheLocal.pub().ref(), hepubk);
-    m_host->m_alias.pub().ref().copyTo(pubk);
-    m_nonce.ref().copyTo(nonce);
-    m_auth[m_auth.size() - 1] = 0x0;
-    encryptECIES(m_remote, &m_auth, m_authCipher);
-
     auto self(shared_from_this());
-    ba::async_write(m_socket->ref(), ba::buffer(m_authCipher), [this, self](boost::system::error_code ec, std::size_t)
-    {
-        transition(ec);
+    offload([this, sig, hepubk, pubk, nonce]() {
+        // E(remote-pubk, S(ecdhe-random, ecdh-shared-secret^nonce) || H(ecdhe-random-pubk) || pubk || nonce || 0x0)
+        Secret staticShared;
+        crypto::ecdh::agree(m_host->m_alias.secret(), m_remote, staticShared);
+        sign(m_ecdheLocal.secret(), staticShared.makeInsecure() ^ m_nonce).ref().copyTo(sig);
+        sha3(m_ecdheLocal.pub().ref(), hepubk);
+        m_host->m_alias.pub().ref().copyTo(pubk);
+        m_nonce.ref().copyTo(nonce);
+        m_auth[m_auth.size() - 1] = 0x0;
+        encryptECIES(m_remote, &m_auth, m_authCipher);
+        return true;
+    }, [this, self](bool) {
+        ba::async_write(m_socket->ref(), ba::buffer(m_authCipher), [this, self](boost::system::error_code ec, std::size_t)
+        {
+            transition(ec);
+        });
     });
 }
 
@@ -63,12 +66,16 @@ void RLPXHandshake::writeAck()
     m_ecdheLocal.pub().ref().copyTo(epubk);
     m_nonce.ref().copyTo(nonce);
     m_ack[m_ack.size() - 1] = 0x0;
-    encryptECIES(m_remote, &m_ack, m_ackCipher);
 
     auto self(shared_from_this());
-    ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher), [this, self](boost::system::error_code ec, std::size_t)
-    {
-        transition(ec);
+    offload([this]() {
+        encryptECIES(m_remote, &m_ack, m_ackCipher);
+        return true;
+    }, [this, self](bool) {
+        ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher), [this, self](boost::system::error_code ec, std::size_t)
+        {
+            transition(ec);
+        });
     });
 }
 
@@ -85,15 +92,18 @@ void RLPXHandshake::writeAckEIP8()
     int padAmount(rand()%100 + 100);
     m_ack.resize(m_ack.size() + padAmount, 0);
 
-    bytes prefix(2);
-    toBigEndian<uint16_t>(m_ack.size() + c_eciesOverhead, prefix);
-    encryptECIES(m_remote, bytesConstRef(&prefix), &m_ack, m_ackCipher);
-    m_ackCipher.insert(m_ackCipher.begin(), prefix.begin(), prefix.end());
-    
     auto self(shared_from_this());
-    ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher), [this, self](boost::system::error_code ec, std::size_t)
-    {
-        transition(ec);
+    offload([this]() {
+        bytes prefix(2);
+        toBigEndian<uint16_t>(m_ack.size() + c_eciesOverhead, prefix);
+        encryptECIES(m_remote, bytesConstRef(&prefix), &m_ack, m_ackCipher);
+        m_ackCipher.insert(m_ackCipher.begin(), prefix.begin(), prefix.end());
+        return true;
+    }, [this, self](bool) {
+        ba::async_write(m_socket->ref(), ba::buffer(m_ackCipher), [this, self](boost::system::error_code ec, std::size_t)
+        {
+            transition(ec);
+        });
     });
 }
 
@@ -115,18 +125,25 @@ void RLPXHandshake::readAuth()
     ba::async_read(m_socket->ref(), ba::buffer(m_authCipher, 307), [this, self](boost::system::error_code ec, std::size_t)
     {
         if (ec)
-            transition(ec);
-        else if (decryptECIES(m_host->m_alias.secret(), bytesConstRef(&m_authCipher), m_auth))
         {
+            transition(ec);
+            return;
+        }
+        offload([this]() {
+            if (!decryptECIES(m_host->m_alias.secret(), bytesConstRef(&m_authCipher), m_auth))
+                return false;
             bytesConstRef data(&m_auth);
             Signature sig(data.cropped(0, Signature::size));
             Public pubk(data.cropped(Signature::size + h256::size, Public::size));
             h256 nonce(data.cropped(Signature::size + h256::size + Public::size, h256::size));
             setAuthValues(sig, pubk, nonce, 4);
-            transition();
-        }
-        else
-            readAuthEIP8();
+            return true;
+        }, [this, self](bool _decrypted) {
+            if (_decrypted)
+                transition();
+            else
+                readAuthEIP8();
+        });
     });
 }
 
@@ -141,11 +158,15 @@ void RLPXHandshake::readAuthEIP8()
     auto self(shared_from_this());
     ba::async_read(m_socket->ref(), rest, [this, self](boost::system::error_code ec, std::size_t)
     {
-        bytesConstRef ct(&m_authCipher);
         if (ec)
-            transition(ec);
-        else if (decryptECIES(m_host->m_alias.secret(), ct.cropped(0, 2), ct.cropped(2), m_auth))
         {
+            transition(ec);
+            return;
+        }
+        offload([this]() {
+            bytesConstRef ct(&m_authCipher);
+            if (!decryptECIES(m_host->m_alias.secret(), ct.cropped(0, 2), ct.cropped(2), m_auth))
+                return false;
             RLP rlp(m_auth, RLP::ThrowOnFail | RLP::FailIfTooSmall);
             setAuthValues(
                 rlp[0].toHash<Signature>(),
@@ -153,16 +174,18 @@ void RLPXHandshake::readAuthEIP8()
                 rlp[2].toHash<h256>(),
                 rlp[3].toInt<uint64_t>()
             );
-            m_nextState = AckAuthEIP8;
-            transition();
-        }
-        else
-        {
-            LOG(m_logger) << "p2p.connect.ingress auth decrypt failed for "
-                          << m_socket->remoteEndpoint();
-            m_nextState = Error;
+            return true;
+        }, [this, self](bool _decrypted) {
+            if (_decrypted)
+                m_nextState = AckAuthEIP8;
+            else
+            {
+                LOG(m_logger) << "p2p.connect.ingress auth decrypt failed for "
+                              << m_socket->remoteEndpoint();
+                m_nextState = Error;
+            }
             transition();
-        }
+        });
     });
 }
 
@@ -174,16 +197,23 @@ void RLPXHandshake::readAck()
     ba::async_read(m_socket->ref(), ba::buffer(m_ackCipher, 210), [this, self](boost::system::error_code ec, std::size_t)
     {
         if (ec)
-            transition(ec);
-        else if (decryptECIES(m_host->m_alias.secret(), bytesConstRef(&m_ackCipher), m_ack))
         {
+            transition(ec);
+            return;
+        }
+        offload([this]() {
+            if (!decryptECIES(m_host->m_alias.secret(), bytesConstRef(&m_ackCipher), m_ack))
+                return false;
             bytesConstRef(&m_ack).cropped(0, Public::size).copyTo(m_ecdheRemote.ref());
             bytesConstRef(&m_ack).cropped(Public::size, h256::size).copyTo(m_remoteNonce.ref());
             m_remoteVersion = 4;
-            transition();
-        }
-        else
-            readAckEIP8();
+            return true;
+        }, [this, self](bool _decrypted) {
+            if (_decrypted)
+                transition();
+            else
+                readAckEIP8();
+        });
     });
 }
 
@@ -198,25 +228,67 @@ void RLPXHandshake::readAckEIP8()
     auto self(shared_from_this());
     ba::async_read(m_socket->ref(), rest, [this, self](boost::system::error_code ec, std::size_t)
     {
-        bytesConstRef ct(&m_ackCipher);
         if (ec)
-            transition(ec);
-        else if (decryptECIES(m_host->m_alias.secret(), ct.cropped(0, 2), ct.cropped(2), m_ack))
         {
+            transition(ec);
+            return;
+        }
+        offload([this]() {
+            bytesConstRef ct(&m_ackCipher);
+            if (!decryptECIES(m_host->m_alias.secret(), ct.cropped(0, 2), ct.cropped(2), m_ack))
+                return false;
             RLP rlp(m_ack, RLP::ThrowOnFail | RLP::FailIfTooSmall);
             m_ecdheRemote = rlp[0].toHash<Public>();
             m_remoteNonce = rlp[1].toHash<h256>();
             m_remoteVersion = rlp[2].toInt<uint64_t>();
+            return true;
+        }, [this, self](bool _decrypted) {
+            if (!_decrypted)
+            {
+                LOG(m_logger) << "p2p.connect.egress ack decrypt failed for "
+                              << m_socket->remoteEndpoint();
+                m_nextState = Error;
+            }
             transition();
+        });
+    });
+}
+
+void RLPXHandshake::offload(function<bool()> _crypto, function<void(bool)> _then)
+{
+    auto self(shared_from_this());
+    // Keeps the socket's io_service running until the result is posted back to it.
+    auto work = make_shared<ba::io_service::work>(m_socket->ref().get_io_service());
+    bool const queued = m_host->m_handshakeWorkers->post([this, self, work, _crypto, _then]() {
+        bool result = false;
+        bool failed = false;
+        try
+        {
+            result = _crypto();
         }
-        else
+        catch (std::exception const& _e)
         {
-            LOG(m_logger) << "p2p.connect.egress ack decrypt failed for "
-                          << m_socket->remoteEndpoint();
-            m_nextState = Error;
-            transition();
+            cnetdetails << "Handshake crypto failed: " << _e.what();
+            failed = true;
         }
+        work->get_io_service().post([this, self, result, failed, _then]() {
+            if (failed || m_cancel)
+            {
+                m_nextState = Error;
+                transition();
+            }
+            else
+                _then(result);
+        });
     });
+
+    if (!queued)
+    {
+        cnetdetails << "Dropping handshake with " << m_socket->remoteEndpoint()
+                    << ": too many handshakes in progress";
+        m_nextState = Error;
+        transition();
+    }
 }
 
 void RLPXHandshake::cancel()
@@ -293,24 +365,31 @@ void RLPXHandshake::transition(boost::system::error_code _ech)
         LOG(m_logger) << (m_originated ? "p2p.connect.egress" : "p2p.connect.ingress")
                       << " sending capabilities handshake";
 
-        /// This pointer will be freed if there is an error otherwise
-        /// it will be passed to Host which will take ownership.
-        m_io.reset(new RLPXFrameCoder(*this));
+        // The frame coder derives the session secrets by ECDH, so it is created on the workers.
+        auto io = make_shared<unique_ptr<RLPXFrameCoder>>();
+        offload([this, io]() {
+            io->reset(new RLPXFrameCoder(*this));
+            return true;
+        }, [this, self, io](bool) {
+            /// This pointer will be freed if there is an error otherwise
+            /// it will be passed to Host which will take ownership.
+            m_io = move(*io);
 
-        RLPStream s;
-        s.append((unsigned)HelloPacket).appendList(5)
-            << dev::p2p::c_protocolVersion
-            << m_host->m_clientVersion
-            << m_host->caps()
-            << m_host->listenPort()
-            << m_host->id();
+            RLPStream s;
+            s.append((unsigned)HelloPacket).appendList(5)
+                << dev::p2p::c_protocolVersion
+                << m_host->m_clientVersion
+                << m_host->caps()
+                << m_host->listenPort()
+                << m_host->id();
 
-        bytes packet;
-        s.swapOut(packet);
-        m_io->writeSingleFramePacket(&packet, m_handshakeOutBuffer);
-        ba::async_write(m_socket->ref(), ba::buffer(m_handshakeOutBuffer), [this, self](boost::system::error_code ec, std::size_t)
-        {
-            transition(ec);
+            bytes packet;
+            s.swapOut(packet);
+            m_io->writeSingleFramePacket(&packet, m_handshakeOutBuffer);
+            ba::async_write(m_socket->ref(), ba::buffer(m_handshakeOutBuffer), [this, self](boost::system::error_code ec, std::size_t)
+            {
+                transition(ec);
+            });
         });
     }
     else if (m_nextState == ReadHello)
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <libdevcrypto/Common.h>
 #include "RLPXSocket.h"
@@ -103,6 +104,10 @@ protected:
     /// Continues reading Ack message in EIP-8 format and transitions to WriteHello.
     void readAckEIP8();
     
+    /// Runs @a _crypto on the handshake workers of the host, then @a _then with its result on the
+    /// network thread. The handshake fails if @a _crypto throws or the workers are saturated.
+    void offload(std::function<bool()> _crypto, std::function<void(bool)> _then);
+
     /// Closes connection and ends transitions.
     void error();
     
@@ -180,14 +180,18 @@ bool Session::interpret(PacketType _t, RLP const& _r)
         break;
     }
     case PongPacket:
+    {
+        chrono::steady_clock::duration latency;
         DEV_GUARDED(x_info)
         {
-            m_info.lastPing = std::chrono::steady_clock::now() - m_ping;
+            latency = m_info.lastPing = std::chrono::steady_clock::now() - m_ping;
             cnetdetails << "Latency: "
                         << chrono::duration_cast<chrono::milliseconds>(m_info.lastPing).count()
                         << " ms";
         }
+        m_server->onPeerPong(m_info.id, latency);
         break;
+    }
     case GetPeersPacket:
     case PeersPacket:
         break;
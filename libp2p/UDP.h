@@ -132,6 +132,9 @@ public:
     void disconnect() { disconnectWithError(boost::asio::error::connection_reset); }
 
 protected:
+    /// Maximum number of datagrams received or sent per completed async operation.
+    static unsigned const c_ioBatch = 64;
+
     void doRead();
 
     void doWrite();
@@ -170,6 +173,8 @@ void UDPSocket<Handler, MaxDatagramSize>::connect()
     {
         m_socket.bind(bi::udp::endpoint(bi::udp::v4(), m_endpoint.port()));
     }
+    // Lets doRead() and doWrite() batch datagrams with synchronous calls that never block.
+    m_socket.non_blocking(true);
 
     // clear write queue so reconnect doesn't send stale messages
     Guard l(x_sendQ);
@@ -210,6 +215,18 @@ void UDPSocket<Handler, MaxDatagramSize>::doRead()
 
         if (_len)
             m_host.onPacketReceived(this, m_recvEndpoint, bytesConstRef(m_recvData.data(), _len));
+
+        // Drain the datagrams already waiting, so that a busy socket needs one async operation
+        // per batch rather than per datagram.
+        for (unsigned i = 1; i < c_ioBatch && !m_closed; ++i)
+        {
+            boost::system::error_code ec;
+            size_t const len = m_socket.receive_from(boost::asio::buffer(m_recvData), m_recvEndpoint, 0, ec);
+            if (ec)
+                break;
+            if (len)
+                m_host.onPacketReceived(this, m_recvEndpoint, bytesConstRef(m_recvData.data(), len));
+        }
         doRead();
     });
 }
@@ -233,6 +250,19 @@ void UDPSocket<Handler, MaxDatagramSize>::doWrite()
 
         Guard l(x_sendQ);
         m_sendQ.pop_front();
+
+        // Send what was queued meanwhile without an async operation per datagram, until the
+        // socket buffer is full.
+        for (unsigned i = 1; i < c_ioBatch && !m_sendQ.empty(); ++i)
+        {
+            boost::system::error_code ec;
+            m_socket.send_to(boost::asio::buffer(m_sendQ[0].data), m_sendQ[0].endpoint(), 0, ec);
+            if (ec == boost::asio::error::would_block)
+                break;
+            if (ec)
+                cnetlog << "Failed delivering UDP message. " << ec.value() << " : " << ec.message();
+            m_sendQ.pop_front();
+        }
         if (m_sendQ.empty())
             return;
         doWrite();
@@ -101,34 +101,41 @@ void AccountHolder::clearQueue(int _id)
 
 AddressHash SimpleAccountHolder::realAccounts() const
 {
+	Guard l(m_keyManager.mutex());
 	return m_keyManager.accountsHash();
 }
 
 pair<bool, Secret> SimpleAccountHolder::authenticate(dev::eth::TransactionSkeleton const& _t)
 {
-	pair<bool, Secret> ret;
-	bool locked = true;
-	if (m_unlockedAccounts.count(_t.from))
-	{
-		chrono::steady_clock::time_point start = m_unlockedAccounts[_t.from].first;
-		chrono::seconds duration(m_unlockedAccounts[_t.from].second);
-		auto end = start + duration;
-		if (start < end && chrono::steady_clock::now() < end)
-			locked = false;
-	}
-	
-	if (locked && m_getAuthorisation)
+	// Keys of unlocked accounts are kept decrypted, so signing with them is cheap and doesn't
+	// serialise on the key store.
+	bool expired = false;
+	DEV_READ_GUARDED(x_unlockedAccounts)
 	{
-		if (m_getAuthorisation(_t, isProxyAccount(_t.from)))
-			locked = false;
-		else
-			BOOST_THROW_EXCEPTION(TransactionRefused());
+		auto it = m_unlockedAccounts.find(_t.from);
+		if (it != m_unlockedAccounts.end())
+		{
+			if (chrono::steady_clock::now() < it->second.expiry)
+				return make_pair(false, it->second.secret);
+			expired = true;
+		}
 	}
-	if (locked)
+	if (expired)
+		DEV_WRITE_GUARDED(x_unlockedAccounts)
+		{
+			auto it = m_unlockedAccounts.find(_t.from);
+			if (it != m_unlockedAccounts.end() && chrono::steady_clock::now() >= it->second.expiry)
+				m_unlockedAccounts.erase(it);
+		}
+
+	pair<bool, Secret> ret;
+	if (!m_getAuthorisation)
 		BOOST_THROW_EXCEPTION(AccountLocked());
+	if (!m_getAuthorisation(_t, isProxyAccount(_t.from)))
+		BOOST_THROW_EXCEPTION(TransactionRefused());
 	if (isRealAccount(_t.from))
 	{
-		if (Secret s = m_keyManager.secret(_t.from, [&](){ return m_getPassword(_t.from); }))
+		if (Secret s = decryptSecret(_t.from, [&](){ return m_getPassword(_t.from); }, true))
 			ret = make_pair(false, s);
 		else
 			BOOST_THROW_EXCEPTION(AccountLocked());
@@ -142,29 +149,81 @@ pair<bool, Secret> SimpleAccountHolder::authenticate(dev::eth::TransactionSkelet
 
 bool SimpleAccountHolder::unlockAccount(Address const& _account, string const& _password, unsigned _duration)
 {
-	if (!m_keyManager.hasAccount(_account))
-		return false;
+	DEV_GUARDED(m_keyManager.mutex())
+		if (!m_keyManager.hasAccount(_account))
+			return false;
 
 	if (_duration == 0)
 		// Lock it even if the password is wrong.
-		m_unlockedAccounts[_account].second = 0;
-
-	m_keyManager.notePassword(_password);
+		DEV_WRITE_GUARDED(x_unlockedAccounts)
+			m_unlockedAccounts.erase(_account);
 
+	Secret s;
+	DEV_GUARDED(m_keyManager.mutex())
+		m_keyManager.notePassword(_password);
 	try
 	{
-		if (!m_keyManager.secret(_account, [&] { return _password; }, false))
-			return false;
+		s = decryptSecret(_account, [&] { return _password; }, false);
 	}
 	catch (PasswordUnknown const&)
 	{
 		return false;
 	}
-	m_unlockedAccounts[_account] = make_pair(chrono::steady_clock::now(), _duration);
+	if (!s)
+		return false;
+
+	if (_duration > 0)
+		DEV_WRITE_GUARDED(x_unlockedAccounts)
+			m_unlockedAccounts[_account] = UnlockedKey{s, chrono::steady_clock::now() + chrono::seconds(_duration)};
 
 	return true;
 }
 
+Secret SimpleAccountHolder::secret(Address const& _account, string const& _password)
+{
+	DEV_GUARDED(m_keyManager.mutex())
+		if (!m_keyManager.hasAccount(_account))
+			return Secret();
+
+	h256 const passwordHash = sha3(_password);
+	DEV_READ_GUARDED(x_unlockedAccounts)
+	{
+		auto it = m_passwordKeys.find(_account);
+		if (it != m_passwordKeys.end() && it->second.first == passwordHash &&
+			chrono::steady_clock::now() < it->second.second.expiry)
+			return it->second.second.secret;
+	}
+
+	Secret s;
+	try
+	{
+		s = decryptSecret(_account, [&] { return _password; }, false);
+	}
+	catch (PasswordUnknown const&)
+	{
+		return Secret();
+	}
+
+	DEV_WRITE_GUARDED(x_unlockedAccounts)
+	{
+		auto const now = chrono::steady_clock::now();
+		for (auto it = m_passwordKeys.begin(); it != m_passwordKeys.end();)
+			if (now >= it->second.second.expiry)
+				it = m_passwordKeys.erase(it);
+			else
+				++it;
+		if (s && m_passwordKeyDuration.count() > 0)
+			m_passwordKeys[_account] = make_pair(passwordHash, UnlockedKey{s, now + m_passwordKeyDuration});
+	}
+	return s;
+}
+
+Secret SimpleAccountHolder::decryptSecret(Address const& _account, function<string()> const& _pass, bool _usePasswordCache)
+{
+	Guard l(m_keyManager.mutex());
+	return m_keyManager.secret(_account, _pass, _usePasswordCache);
+}
+
 pair<bool, Secret> FixedAccountHolder::authenticate(dev::eth::TransactionSkeleton const& _t)
 {
 	pair<bool, Secret> ret;
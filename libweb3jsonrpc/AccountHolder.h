@@ -28,6 +28,8 @@
 #include <vector>
 #include <map>
 #include <chrono>
+#include <unordered_map>
+#include <libdevcore/Guards.h>
 #include <libethcore/CommonJS.h>
 #include <libethereum/Transaction.h>
 
@@ -72,6 +74,13 @@ public:
 		return false;
 	}
 
+	/// @returns the secret key of @a _account decrypted with @a _password, or a null secret if the
+	/// password is wrong. Only works for direct accounts.
+	virtual Secret secret(Address const& /*_account*/, std::string const& /*_password*/)
+	{
+		return Secret();
+	}
+
 	int addProxyAccount(Address const& _account);
 	bool removeProxyAccount(unsigned _id);
 	void queueTransaction(eth::TransactionSkeleton const& _transaction);
@@ -104,11 +113,34 @@ public:
 
 	bool unlockAccount(Address const& _account, std::string const& _password, unsigned _duration) override;
 
+	/// Keeps the keys decrypted by secret() for @a _duration, so that sending many transactions
+	/// with the password doesn't run the key derivation for each. Zero disables the cache.
+	void setPasswordKeyDuration(std::chrono::seconds _duration) { m_passwordKeyDuration = _duration; }
+	Secret secret(Address const& _account, std::string const& _password) override;
+
 private:
+	struct UnlockedKey
+	{
+		Secret secret;
+		std::chrono::steady_clock::time_point expiry;
+	};
+
+	/// Decrypts the key of @a _account with the key store. Takes the key derivation time, during
+	/// which the key manager is locked.
+	Secret decryptSecret(Address const& _account, std::function<std::string()> const& _pass, bool _usePasswordCache);
+
 	std::function<std::string(Address)> m_getPassword;
 	std::function<bool(TransactionSkeleton const&, bool)> m_getAuthorisation;
+	/// Every call holds KeyManager::mutex(), shared with the other RPC handlers. Key derivations
+	/// of keys not cached here are therefore serialised.
 	KeyManager& m_keyManager;
-	std::map<Address, std::pair<std::chrono::steady_clock::time_point, unsigned>> m_unlockedAccounts;
+
+	mutable SharedMutex x_unlockedAccounts;
+	/// Decrypted keys of the accounts unlocked with unlockAccount(), until they expire.
+	std::unordered_map<Address, UnlockedKey> m_unlockedAccounts;
+	/// Decrypted keys returned by secret(), with the hash of the password they were decrypted with.
+	std::unordered_map<Address, std::pair<h256, UnlockedKey>> m_passwordKeys;
+	std::chrono::seconds m_passwordKeyDuration{60};
 };
 
 class FixedAccountHolder: public AccountHolder
@@ -99,8 +99,13 @@ Json::Value AdminEth::admin_eth_allAccounts(string const& _session)
     u256 total = 0;
     u256 pendingtotal = 0;
     Address beneficiary;
-    for (auto const& address: m_keyManager.accounts())
+    vector<pair<Address, string>> accounts;
+    DEV_GUARDED(m_keyManager.mutex())
+        for (auto const& address: m_keyManager.accounts())
+            accounts.emplace_back(address, m_keyManager.accountName(address));
+    for (auto const& account: accounts)
     {
+        Address const& address = account.first;
         auto pending = m_eth.balanceAt(address, PendingBlock);
         auto latest = m_eth.balanceAt(address, LatestBlock);
         Json::Value a;
@@ -111,7 +116,7 @@ Json::Value AdminEth::admin_eth_allAccounts(string const& _session)
         a["nicebalance"] = formatBalance(latest);
         a["pending"] = toJS(pending);
         a["nicepending"] = formatBalance(pending);
-        ret["accounts"][m_keyManager.accountName(address)] = a;
+        ret["accounts"][account.second] = a;
         total += latest;
         pendingtotal += pending;
     }
@@ -130,6 +135,7 @@ Json::Value AdminEth::admin_eth_newAccount(Json::Value const& _info, string cons
     string name = _info["name"].asString();
     KeyPair kp = KeyPair::create();
     h128 uuid;
+    Guard l(m_keyManager.mutex());
     if (_info.isMember("password"))
     {
         string password = _info["password"].asString();
@@ -255,7 +261,10 @@ bool AdminEth::miner_setEtherbase(string const& _uuidOrAddress)
     Address a;
     h128 uuid = fromUUID(_uuidOrAddress);
     if (uuid)
-        a = m_keyManager.address(uuid);
+    {
+        DEV_GUARDED(m_keyManager.mutex())
+            a = m_keyManager.address(uuid);
+    }
     else if (isHash<Address>(_uuidOrAddress))
         a = Address(_uuidOrAddress);
     else
@@ -4,6 +4,7 @@
 #include <libethcore/CommonJS.h>
 #include <libethereum/Client.h>
 #include <libethereum/Executive.h>
+#include <libethereum/TransactionPerformance.h>
 #include "Debug.h"
 #include "JsonHelper.h"
 using namespace std;
@@ -224,6 +225,17 @@ std::string Debug::debug_preimage(std::string const& _hashedKey)
     return key.empty() ? std::string() : toHexPrefixed(key);
 }
 
+Json::Value Debug::debug_transactionPerformance(int _count)
+{
+    if (_count < 0)
+        throw jsonrpc::JsonRpcException("Negative count");
+
+    Json::Value ret(Json::arrayValue);
+    for (auto const& record : TransactionPerformanceLog::instance().records(_count))
+        ret.append(toJson(record));
+    return ret;
+}
+
 Json::Value Debug::debug_traceCall(Json::Value const& _call, std::string const& _blockNumber, Json::Value const& _options)
 {
     Json::Value ret;
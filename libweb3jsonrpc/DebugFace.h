@@ -21,6 +21,7 @@ namespace dev {
                     this->bindAndAddMethod(jsonrpc::Procedure("debug_traceBlockByNumber", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_INTEGER,"param2",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_traceBlockByNumberI);
                     this->bindAndAddMethod(jsonrpc::Procedure("debug_traceBlockByHash", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_STRING,"param2",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_traceBlockByHashI);
                     this->bindAndAddMethod(jsonrpc::Procedure("debug_traceCall", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_OBJECT,"param2",jsonrpc::JSON_STRING,"param3",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_traceCallI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("debug_transactionPerformance", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_ARRAY, "param1",jsonrpc::JSON_INTEGER, NULL), &dev::rpc::DebugFace::debug_transactionPerformanceI);
                 }
                 inline virtual void debug_accountRangeAtI(const Json::Value &request, Json::Value &response)
                 {
@@ -50,6 +51,10 @@ namespace dev {
                 {
                     response = this->debug_traceCall(request[0u], request[1u].asString(), request[2u]);
                 }
+                inline virtual void debug_transactionPerformanceI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->debug_transactionPerformance(request[0u].asInt());
+                }
                 virtual Json::Value debug_accountRangeAt(const std::string& param1, int param2, const std::string& param3, int param4) = 0;
                 virtual Json::Value debug_traceTransaction(const std::string& param1, const Json::Value& param2) = 0;
                 virtual Json::Value debug_storageRangeAt(const std::string& param1, int param2, const std::string& param3, const std::string& param4, int param5) = 0;
@@ -57,6 +62,7 @@ namespace dev {
                 virtual Json::Value debug_traceBlockByNumber(int param1, const Json::Value& param2) = 0;
                 virtual Json::Value debug_traceBlockByHash(const std::string& param1, const Json::Value& param2) = 0;
                 virtual Json::Value debug_traceCall(const Json::Value& param1, const std::string& param2, const Json::Value& param3) = 0;
+                virtual Json::Value debug_transactionPerformance(int param1) = 0;
         };
 
     }
@@ -238,6 +238,22 @@ string Eth::eth_getCode(string const& _address, string const& _blockNumber)
 	}
 }
 
+Json::Value Eth::eth_getProof(string const& _address, Json::Value const& _storageKeys, string const& _blockNumber)
+{
+	try
+	{
+		Address const address = jsToAddress(_address);
+		u256s keys;
+		for (auto const& key: _storageKeys)
+			keys.push_back(jsToU256(key.asString()));
+		return toJson(client()->proofAt(address, keys, jsToBlockNumber(_blockNumber)), address);
+	}
+	catch (...)
+	{
+		BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
+	}
+}
+
 void Eth::setTransactionDefaults(TransactionSkeleton& _t)
 {
 	if (!_t.from)
@@ -742,6 +758,10 @@ string dev::rpc::exceptionToErrorMessage()
 	{
 		ret = "Same transaction already exists in the pending transaction queue.";
 	}
+	catch (TooManyPendingTransactions const&)
+	{
+		ret = "Too many transactions from the same sender in the pending transaction queue.";
+	}
 	catch (TransactionAlreadyInChain const&)
 	{
 		ret = "Transaction is already in the blockchain.";
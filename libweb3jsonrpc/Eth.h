@@ -86,6 +86,7 @@ public:
 	virtual Json::Value eth_getUncleCountByBlockHash(std::string const& _blockHash) override;
 	virtual Json::Value eth_getUncleCountByBlockNumber(std::string const& _blockNumber) override;
 	virtual std::string eth_getCode(std::string const& _address, std::string const& _blockNumber) override;
+	virtual Json::Value eth_getProof(std::string const& _address, Json::Value const& _storageKeys, std::string const& _blockNumber) override;
 	virtual std::string eth_sendTransaction(Json::Value const& _json) override;
 	virtual std::string eth_call(Json::Value const& _json, std::string const& _blockNumber) override;
 	virtual std::string eth_estimateGas(Json::Value const& _json) override;
@@ -31,6 +31,7 @@ namespace dev {
                     this->bindAndAddMethod(jsonrpc::Procedure("eth_getUncleCountByBlockHash", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_STRING, NULL), &dev::rpc::EthFace::eth_getUncleCountByBlockHashI);
                     this->bindAndAddMethod(jsonrpc::Procedure("eth_getUncleCountByBlockNumber", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_STRING, NULL), &dev::rpc::EthFace::eth_getUncleCountByBlockNumberI);
                     this->bindAndAddMethod(jsonrpc::Procedure("eth_getCode", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING, "param1",jsonrpc::JSON_STRING,"param2",jsonrpc::JSON_STRING, NULL), &dev::rpc::EthFace::eth_getCodeI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("eth_getProof", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_STRING,"param2",jsonrpc::JSON_ARRAY,"param3",jsonrpc::JSON_STRING, NULL), &dev::rpc::EthFace::eth_getProofI);
                     this->bindAndAddMethod(jsonrpc::Procedure("eth_sendTransaction", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING, "param1",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::EthFace::eth_sendTransactionI);
                     this->bindAndAddMethod(jsonrpc::Procedure("eth_call", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING, "param1",jsonrpc::JSON_OBJECT,"param2",jsonrpc::JSON_STRING, NULL), &dev::rpc::EthFace::eth_callI);
                     this->bindAndAddMethod(jsonrpc::Procedure("eth_flush", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_BOOLEAN,  NULL), &dev::rpc::EthFace::eth_flushI);
@@ -144,6 +145,10 @@ namespace dev {
                 {
                     response = this->eth_getCode(request[0u].asString(), request[1u].asString());
                 }
+                inline virtual void eth_getProofI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->eth_getProof(request[0u].asString(), request[1u], request[2u].asString());
+                }
                 inline virtual void eth_sendTransactionI(const Json::Value &request, Json::Value &response)
                 {
                     response = this->eth_sendTransaction(request[0u]);
@@ -307,6 +312,7 @@ namespace dev {
                 virtual Json::Value eth_getUncleCountByBlockHash(const std::string& param1) = 0;
                 virtual Json::Value eth_getUncleCountByBlockNumber(const std::string& param1) = 0;
                 virtual std::string eth_getCode(const std::string& param1, const std::string& param2) = 0;
+                virtual Json::Value eth_getProof(const std::string& param1, const Json::Value& param2, const std::string& param3) = 0;
                 virtual std::string eth_sendTransaction(const Json::Value& param1) = 0;
                 virtual std::string eth_call(const Json::Value& param1, const std::string& param2) = 0;
                 virtual bool eth_flush() = 0;
@@ -24,6 +24,7 @@
 
 #include <libethcore/SealEngine.h>
 #include <libethereum/Client.h>
+#include <libethereum/TransactionPerformance.h>
 #include <libwebthree/WebThree.h>
 #include <libethcore/CommonJS.h>
 #include <jsonrpccpp/common/exception.h>
@@ -217,6 +218,54 @@ Json::Value toJson(dev::eth::LocalisedTransactionReceipt const& _t)
     return res;
 }
 
+Json::Value toJson(dev::eth::TransactionPerformance const& _p)
+{
+    Json::Value res;
+    res["transactionHash"] = toJS(_p.transaction);
+    res["blockNumber"] = _p.blockNumber;
+    res["transactionIndex"] = _p.index;
+    res["to"] = _p.to ? toJS(_p.to) : Json::Value();
+    res["microseconds"] = Json::UInt64(_p.microseconds);
+    res["gasUsed"] = toJS(_p.gasUsed);
+    res["stateReads"] = Json::UInt64(_p.counters.stateReads);
+    res["stateWrites"] = Json::UInt64(_p.counters.stateWrites);
+    res["dbMisses"] = Json::UInt64(_p.counters.dbMisses);
+    res["vm"] = _p.vm;
+    Json::Value precompiles(Json::objectValue);
+    for (auto const& p : _p.counters.precompiles)
+        precompiles[toJS(p.first)] = p.second;
+    res["precompiles"] = precompiles;
+    return res;
+}
+
+Json::Value toJson(dev::eth::AccountProof const& _p, Address const& _address)
+{
+    Json::Value res;
+    res["address"] = toJS(_address);
+    res["nonce"] = toJS(_p.nonce);
+    res["balance"] = toJS(_p.balance);
+    res["storageHash"] = toJS(_p.storageRoot);
+    res["codeHash"] = toJS(_p.codeHash);
+    Json::Value accountProof(Json::arrayValue);
+    for (auto const& n : _p.proof)
+        accountProof.append(toJS(n));
+    res["accountProof"] = accountProof;
+    Json::Value storageProof(Json::arrayValue);
+    for (auto const& s : _p.storage)
+    {
+        Json::Value slot;
+        slot["key"] = toJS(s.key);
+        slot["value"] = toJS(s.value);
+        Json::Value proof(Json::arrayValue);
+        for (auto const& n : s.proof)
+            proof.append(toJS(n));
+        slot["proof"] = proof;
+        storageProof.append(slot);
+    }
+    res["storageProof"] = storageProof;
+    return res;
+}
+
 Json::Value toJson(dev::eth::Transaction const& _t)
 {
     Json::Value res;
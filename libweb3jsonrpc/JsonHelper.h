@@ -48,6 +48,8 @@ class Transaction;
 class LocalisedTransaction;
 class SealEngineFace;
 struct BlockDetails;
+struct TransactionPerformance;
+struct AccountProof;
 class Interface;
 using Transactions = std::vector<Transaction>;
 using UncleHashes = h256s;
@@ -64,6 +66,8 @@ Json::Value toJson(Transaction const& _t, bytes const& _rlp);
 Json::Value toJson(LocalisedTransaction const& _t);
 Json::Value toJson(TransactionReceipt const& _t);
 Json::Value toJson(LocalisedTransactionReceipt const& _t);
+Json::Value toJson(TransactionPerformance const& _p);
+Json::Value toJson(AccountProof const& _p, Address const& _address);
 Json::Value toJson(LocalisedLogEntry const& _e);
 Json::Value toJson(LogEntry const& _e);
 Json::Value toJson(std::unordered_map<h256, LocalisedLogEntries> const& _entriesByBlock);
@@ -23,7 +23,8 @@ Personal::Personal(KeyManager& _keyManager, AccountHolder& _accountHolder, eth::
 std::string Personal::personal_newAccount(std::string const& _password)
 {
 	KeyPair p = KeyManager::newKeyPair(KeyManager::NewKeyType::NoVanity);
-	m_keyManager.import(p.secret(), std::string(), _password, std::string());
+	DEV_GUARDED(m_keyManager.mutex())
+		m_keyManager.import(p.secret(), std::string(), _password, std::string());
 	return toJS(p.address());
 }
 
@@ -39,7 +40,7 @@ string Personal::personal_sendTransaction(Json::Value const& _transaction, strin
 		BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
 	}
 
-	if (Secret s = m_keyManager.secret(t.from, [&](){ return _password; }, false))
+	if (Secret s = m_accountHolder.secret(t.from, _password))
 	{
 		// return the tx hash
 		return toJS(m_eth.submitTransaction(t, s));
@@ -59,5 +60,8 @@ bool Personal::personal_unlockAccount(std::string const& _address, std::string c
 
 Json::Value Personal::personal_listAccounts()
 {
-	return toJson(m_keyManager.accounts());
+	Addresses accounts;
+	DEV_GUARDED(m_keyManager.mutex())
+		accounts = m_keyManager.accounts();
+	return toJson(accounts);
 }
@@ -22,6 +22,8 @@
 #include <clocale>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
@@ -49,6 +51,7 @@ enum class Mode {
     ListArchive,
     ExtractArchive,
     Render,
+    Stream,
     Create
 };
 
@@ -126,6 +129,153 @@ private:
     Prefs m_prefs;
 };
 
+/// Reads the top-level RLP items of a binary input one at a time, so that inputs of any size
+/// (e.g. chain exports, which are concatenated blocks) can be processed in bounded memory.
+class RLPItemReader
+{
+public:
+    /// Largest item accepted, so that a corrupt length does not make next() allocate unbounded
+    /// memory.
+    static size_t const c_maxItemSize = 256 * 1024 * 1024;
+
+    explicit RLPItemReader(istream& _in): m_in(_in)
+    {
+        // When the input is seekable, lengths are also checked against what is left of it.
+        streampos const start = m_in.tellg();
+        if (start != streampos(-1) && m_in.seekg(0, ios::end))
+        {
+            m_end = m_in.tellg();
+            m_in.seekg(start);
+        }
+        m_in.clear();
+    }
+
+    /// Reads the next item into @a o_item. @returns false at the end of the input.
+    /// @throws runtime_error if the item is truncated or larger than c_maxItemSize.
+    bool next(bytes& o_item)
+    {
+        int const first = m_in.get();
+        if (first == EOF)
+            return false;
+        o_item.clear();
+        o_item.push_back(static_cast<byte>(first));
+
+        size_t const payload = readLength(static_cast<byte>(first), o_item);
+        if (payload > c_maxItemSize)
+            throw runtime_error("item too large");
+        if (m_end != streampos(-1) && m_end - m_in.tellg() < streamoff(payload))
+            throw runtime_error("truncated input");
+        size_t const headerSize = o_item.size();
+        o_item.resize(headerSize + payload);
+        read(o_item.data() + headerSize, payload);
+        return true;
+    }
+
+    /// Reads the header of a list, so that its elements are the next items read.
+    void unwrapList()
+    {
+        int const first = m_in.get();
+        if (first == EOF || first < 0xc0)
+            throw runtime_error("the input is not a list");
+        bytes header{static_cast<byte>(first)};
+        readLength(static_cast<byte>(first), header);
+    }
+
+private:
+    /// Reads the rest of the item header starting with @a _first into @a io_header.
+    /// @returns the payload length.
+    size_t readLength(byte _first, bytes& io_header)
+    {
+        if (_first < 0x80)
+        {
+            // The byte is the item itself.
+            io_header.clear();
+            m_in.unget();
+            return 1;
+        }
+        if (_first <= 0xb7)
+            return _first - 0x80;
+        if (_first < 0xc0)
+            return readLongLength(_first - 0xb7, io_header);
+        if (_first <= 0xf7)
+            return _first - 0xc0;
+        return readLongLength(_first - 0xf7, io_header);
+    }
+
+    size_t readLongLength(unsigned _lengthSize, bytes& io_header)
+    {
+        if (_lengthSize > sizeof(size_t))
+            throw runtime_error("item too large");
+        byte lengthBytes[sizeof(size_t)];
+        read(lengthBytes, _lengthSize);
+        io_header.insert(io_header.end(), lengthBytes, lengthBytes + _lengthSize);
+        size_t length = 0;
+        for (unsigned i = 0; i < _lengthSize; ++i)
+            length = (length << 8) | lengthBytes[i];
+        return length;
+    }
+
+    void read(byte* _data, size_t _size)
+    {
+        if (!m_in.read(reinterpret_cast<char*>(_data), _size))
+            throw runtime_error("truncated input");
+    }
+
+    istream& m_in;
+    streampos m_end = streampos(-1);  ///< End of the input, if it is seekable.
+};
+
+/// Index of a path step matching all the elements of a list.
+int const c_anyElement = -1;
+
+/// Parses a path such as "[1][*][3]". @returns false if it is malformed.
+bool parsePath(string const& _path, vector<int>& o_path)
+{
+    o_path.clear();
+    size_t i = 0;
+    while (i < _path.size())
+    {
+        size_t const close = _path.find(']', i);
+        if (_path[i] != '[' || close == string::npos || close == i + 1)
+            return false;
+        string const step = _path.substr(i + 1, close - i - 1);
+        if (step == "*")
+            o_path.push_back(c_anyElement);
+        else if (step.find_first_not_of("0123456789") == string::npos)
+        {
+            try
+            {
+                o_path.push_back(stoi(step));
+            }
+            catch (out_of_range const&)
+            {
+                return false;
+            }
+        }
+        else
+            return false;
+        i = close + 1;
+    }
+    return true;
+}
+
+/// Collects into @a o_selected the sub-items of @a _item at @a _path, skipping missing ones.
+void selectPath(RLP const& _item, vector<int> const& _path, size_t _step, vector<RLP>& o_selected)
+{
+    if (_step == _path.size())
+    {
+        o_selected.push_back(_item);
+        return;
+    }
+    if (!_item.isList())
+        return;
+    if (_path[_step] == c_anyElement)
+        for (auto const& i: _item)
+            selectPath(i, _path, _step + 1, o_selected);
+    else if (static_cast<size_t>(_path[_step]) < _item.itemCount())
+        selectPath(_item[_path[_step]], _path, _step + 1, o_selected);
+}
+
 void putOut(bytes _out, Encoding _encoding, bool _encrypt, bool _quiet)
 {
     dev::h256 h = dev::sha3(_out);
@@ -151,6 +301,95 @@ void putOut(bytes _out, Encoding _encoding, bool _encrypt, bool _quiet)
     }
 }
 
+/// Renders each top-level item of @a _in, or its sub-items at @a _path, one per line. Batches of
+/// items are rendered on @a _jobs threads and output in the input order.
+bool streamItems(istream& _in, RLPStreamer::Prefs const& _prefs, vector<int> const& _path,
+    bool _rawHex, bool _unwrap, unsigned _jobs, bool _lenience)
+{
+    size_t const c_maxBatchItems = 256 * _jobs;
+    size_t const c_maxBatchBytes = 64 * 1024 * 1024;
+
+    RLPItemReader reader(_in);
+    if (_unwrap)
+        reader.unwrapList();
+
+    vector<bytes> batch;
+    vector<string> rendered;
+    vector<char> failed;
+    size_t itemNumber = 0;
+    bool more = true;
+    while (more)
+    {
+        batch.clear();
+        size_t batchBytes = 0;
+        bytes item;
+        string readError;
+        try
+        {
+            while (batch.size() < c_maxBatchItems && batchBytes < c_maxBatchBytes &&
+                   (more = reader.next(item)))
+            {
+                batchBytes += item.size();
+                batch.push_back(move(item));
+            }
+        }
+        catch (exception const& _e)
+        {
+            // Output the items read before reporting the error.
+            readError = _e.what();
+            more = false;
+        }
+
+        rendered.assign(batch.size(), string());
+        failed.assign(batch.size(), false);
+        auto renderRange = [&](size_t _first) {
+            for (size_t i = _first; i < batch.size(); i += _jobs)
+            {
+                try
+                {
+                    vector<RLP> selected;
+                    selectPath(RLP(batch[i]), _path, 0, selected);
+                    ostringstream out;
+                    RLPStreamer streamer(out, _prefs);
+                    for (auto const& r: selected)
+                    {
+                        if (_rawHex)
+                            out << toHex(r.data());
+                        else
+                            streamer.output(r);
+                        out << "\n";
+                    }
+                    rendered[i] = out.str();
+                }
+                catch (...)
+                {
+                    failed[i] = true;
+                }
+            }
+        };
+        vector<thread> workers;
+        for (unsigned j = 1; j < _jobs && j < batch.size(); ++j)
+            workers.emplace_back(renderRange, j);
+        renderRange(0);
+        for (auto& w: workers)
+            w.join();
+
+        for (size_t i = 0; i < batch.size(); ++i, ++itemNumber)
+            if (failed[i])
+            {
+                cerr << "Error: Invalid format; bad RLP in item " << itemNumber << "." << endl;
+                if (!_lenience)
+                    return false;
+            }
+            else
+                cout << rendered[i];
+
+        if (!readError.empty())
+            throw runtime_error(readError + " after item " + toString(itemNumber));
+    }
+    return true;
+}
+
 int main(int argc, char** argv)
 {
     setDefaultOrCLocale();
@@ -176,6 +415,15 @@ int main(int argc, char** argv)
         "force-escape", "When rendering as C-style strings, force all characters to be escaped.");
     addRenderOption("force-hex", "Force all data to be rendered as raw hex.");
 
+    po::options_description streamOptions("Stream options");
+    auto addStreamOption = streamOptions.add_options();
+    addStreamOption("path,p", po::value<string>()->value_name("<path>"),
+        "Render only the sub-items of each item at the given path, e.g. [1][*][3].");
+    addStreamOption("raw-hex", "Output the RLP of the items in hex instead of rendering them.");
+    addStreamOption("unwrap", "Stream the elements of the list the input consists of.");
+    addStreamOption("jobs,j", po::value<unsigned>()->value_name("<n>"),
+        "Number of threads rendering the items (default: number of cores).");
+
     po::options_description generalOptions("General options");
     auto addGeneralOption = generalOptions.add_options();
     addGeneralOption("dapp,D", "Dapp-building mode; equivalent to --encrypt --base-64.");
@@ -190,7 +438,7 @@ int main(int argc, char** argv)
     addGeneralOption("version,V", "Show the version and exit.");
 
     po::options_description allowedOptions("Allowed options");
-    allowedOptions.add(generalOptions).add(renderOptions);
+    allowedOptions.add(generalOptions).add(renderOptions).add(streamOptions);
 
     po::variables_map vm;
     vector<string> unrecognisedOptions;
@@ -215,6 +463,8 @@ int main(int argc, char** argv)
             mode = Mode::Render;
         else if (arg == "create")
             mode = Mode::Create;
+        else if (arg == "stream")
+            mode = Mode::Stream;
         else if (arg == "list")
             mode = Mode::ListArchive;
         else if (arg == "extract")
@@ -233,7 +483,8 @@ int main(int argc, char** argv)
              << "    list     [ <file> | -- ]  List the items in the RLP list by hash and size." << endl
              << "    extract  [ <file> | -- ]  Extract all items in the RLP list, named by hash." << endl
              << "    assemble [ <manifest> | <base path> ] <file> ...  Given a manifest & files, output the RLP." << endl
-             << renderOptions << generalOptions;
+             << "    stream   [ <file> | -- ]  Render each item of a binary RLP stream of any size, one per line." << endl
+             << renderOptions << streamOptions << generalOptions;
         exit(0);
     }
     if (vm.count("lenience"))
@@ -269,6 +520,39 @@ int main(int argc, char** argv)
     if (vm.count("force-escape"))
         prefs.escapeAll = true;
 
+    if (mode == Mode::Stream)
+    {
+        vector<int> path;
+        if (vm.count("path") && !parsePath(vm["path"].as<string>(), path))
+        {
+            cerr << "Error: Invalid path; expected e.g. [1][*][3]." << endl;
+            return -1;
+        }
+        unsigned jobs = vm.count("jobs") ? vm["jobs"].as<unsigned>() : thread::hardware_concurrency();
+
+        ifstream file;
+        if (inputFile != "--")
+        {
+            file.open(inputFile, ios::binary);
+            if (!file)
+            {
+                cerr << "Error: Can't open " << inputFile << "." << endl;
+                return -1;
+            }
+        }
+        try
+        {
+            bool const ok = streamItems(inputFile == "--" ? cin : file, prefs, path,
+                vm.count("raw-hex") > 0, vm.count("unwrap") > 0, max(1u, jobs), lenience);
+            return ok ? 0 : 1;
+        }
+        catch (exception const& _e)
+        {
+            cerr << "Error: Invalid format; " << _e.what() << "." << endl;
+            return 1;
+        }
+    }
+
     bytes in;
     if (inputFile == "--")
         for (int i = cin.get(); i != -1; i = cin.get())
@@ -0,0 +1,212 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Benchmarks of RLP, hashing, trie and state database primitives.
+
+#include <libdevcore/DBFactory.h>
+#include <libdevcore/OverlayDB.h>
+#include <libdevcore/RLP.h>
+#include <libdevcore/SHA3.h>
+#include <libdevcore/TransientDirectory.h>
+#include <libdevcore/TrieDB.h>
+#include <libdevcrypto/Hash.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::db;
+
+namespace
+{
+/// Number of entries written to the trie in a single benchmark iteration.
+unsigned const c_trieEntries = 1000;
+
+/// An OverlayDB backed by a fresh database of the kind given as the benchmark argument.
+class BenchmarkDB
+{
+public:
+    explicit BenchmarkDB(int64_t _kind)
+      : m_db(DBFactory::create(static_cast<DatabaseKind>(_kind), m_dir.path()))
+    {}
+
+    OverlayDB& db() { return m_db; }
+
+private:
+    TransientDirectory m_dir;
+    OverlayDB m_db;
+};
+
+h256s trieKeys(unsigned _count, unsigned _salt = 0)
+{
+    h256s keys;
+    for (unsigned i = 0; i < _count; ++i)
+        keys.push_back(sha3(h256(i + _salt)));
+    return keys;
+}
+
+void rlpEncodeList(benchmark::State& _state)
+{
+    h256s const items = trieKeys(16);
+    for (auto _: _state)
+    {
+        RLPStream s(items.size() + 2);
+        for (auto const& i: items)
+            s << i;
+        s << u256(0xdeadbeef) << string("aleth");
+        benchmark::DoNotOptimize(s.out());
+    }
+    _state.SetItemsProcessed(_state.iterations());
+}
+BENCHMARK(rlpEncodeList);
+
+void rlpDecodeList(benchmark::State& _state)
+{
+    RLPStream s(18);
+    for (auto const& i: trieKeys(16))
+        s << i;
+    s << u256(0xdeadbeef) << string("aleth");
+    bytes const encoded = s.out();
+    for (auto _: _state)
+    {
+        RLP const r(encoded);
+        h256 acc;
+        for (unsigned i = 0; i < 16; ++i)
+            acc ^= r[i].toHash<h256>();
+        benchmark::DoNotOptimize(acc);
+        benchmark::DoNotOptimize(r[16].toInt<u256>());
+        benchmark::DoNotOptimize(r[17].toString());
+    }
+    _state.SetBytesProcessed(_state.iterations() * encoded.size());
+}
+BENCHMARK(rlpDecodeList);
+
+void fixedHashCompare(benchmark::State& _state)
+{
+    h256 const a = sha3(bytes{1});
+    h256 b = a;
+    for (auto _: _state)
+    {
+        benchmark::DoNotOptimize(a == b);
+        benchmark::DoNotOptimize(a < b);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(fixedHashCompare);
+
+void fixedHashBitOps(benchmark::State& _state)
+{
+    h2048 bloom;
+    h256 const topic = sha3(bytes{1});
+    for (auto _: _state)
+    {
+        bloom.shiftBloom<3>(topic);
+        benchmark::DoNotOptimize(bloom.containsBloom<3>(topic));
+    }
+}
+BENCHMARK(fixedHashBitOps);
+
+void sha3Hash(benchmark::State& _state)
+{
+    bytes const data(_state.range(0), 0xaa);
+    for (auto _: _state)
+        benchmark::DoNotOptimize(sha3(data));
+    _state.SetBytesProcessed(_state.iterations() * data.size());
+}
+BENCHMARK(sha3Hash)->Arg(32)->Arg(1024)->Arg(64 * 1024);
+
+void sha256Hash(benchmark::State& _state)
+{
+    bytes const data(_state.range(0), 0xaa);
+    for (auto _: _state)
+        benchmark::DoNotOptimize(sha256(&data));
+    _state.SetBytesProcessed(_state.iterations() * data.size());
+}
+BENCHMARK(sha256Hash)->Arg(32)->Arg(1024)->Arg(64 * 1024);
+
+void trieInsert(benchmark::State& _state)
+{
+    h256s const keys = trieKeys(c_trieEntries);
+    for (auto _: _state)
+    {
+        _state.PauseTiming();
+        BenchmarkDB db(_state.range(0));
+        GenericTrieDB<OverlayDB> trie(&db.db());
+        trie.init();
+        _state.ResumeTiming();
+
+        for (auto const& k: keys)
+            trie.insert(k.ref(), k.ref());
+        benchmark::DoNotOptimize(trie.root());
+    }
+    _state.SetItemsProcessed(_state.iterations() * keys.size());
+}
+BENCHMARK(trieInsert)
+    ->Arg(static_cast<int64_t>(DatabaseKind::MemoryDB))
+    ->Arg(static_cast<int64_t>(DatabaseKind::LevelDB));
+
+void trieLookup(benchmark::State& _state)
+{
+    h256s const keys = trieKeys(c_trieEntries);
+    BenchmarkDB db(_state.range(0));
+    GenericTrieDB<OverlayDB> trie(&db.db());
+    trie.init();
+    for (auto const& k: keys)
+        trie.insert(k.ref(), k.ref());
+    db.db().commit();
+
+    for (auto _: _state)
+        for (auto const& k: keys)
+            benchmark::DoNotOptimize(trie.at(k.ref()));
+    _state.SetItemsProcessed(_state.iterations() * keys.size());
+}
+BENCHMARK(trieLookup)
+    ->Arg(static_cast<int64_t>(DatabaseKind::MemoryDB))
+    ->Arg(static_cast<int64_t>(DatabaseKind::LevelDB));
+
+void trieCommit(benchmark::State& _state)
+{
+    BenchmarkDB db(_state.range(0));
+    GenericTrieDB<OverlayDB> trie(&db.db());
+    trie.init();
+    unsigned salt = 0;
+    for (auto _: _state)
+    {
+        _state.PauseTiming();
+        for (auto const& k: trieKeys(c_trieEntries, salt))
+            trie.insert(k.ref(), k.ref());
+        salt += c_trieEntries;
+        _state.ResumeTiming();
+
+        db.db().commit();
+    }
+    _state.SetItemsProcessed(_state.iterations() * c_trieEntries);
+}
+BENCHMARK(trieCommit)
+    ->Arg(static_cast<int64_t>(DatabaseKind::MemoryDB))
+    ->Arg(static_cast<int64_t>(DatabaseKind::LevelDB));
+
+void overlayDBCommit(benchmark::State& _state)
+{
+    BenchmarkDB db(_state.range(0));
+    bytes const value(100, 0xaa);
+    unsigned salt = 0;
+    for (auto _: _state)
+    {
+        _state.PauseTiming();
+        for (auto const& k: trieKeys(c_trieEntries, salt))
+            db.db().insert(k, &value);
+        salt += c_trieEntries;
+        _state.ResumeTiming();
+
+        db.db().commit();
+    }
+    _state.SetItemsProcessed(_state.iterations() * c_trieEntries);
+}
+BENCHMARK(overlayDBCommit)
+    ->Arg(static_cast<int64_t>(DatabaseKind::MemoryDB))
+    ->Arg(static_cast<int64_t>(DatabaseKind::LevelDB));
+
+}  // namespace
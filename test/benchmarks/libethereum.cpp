@@ -0,0 +1,118 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Benchmarks of transaction, block header, transaction queue and log filter processing.
+
+#include <libdevcrypto/Common.h>
+#include <libethashseal/GenesisInfo.h>
+#include <libethcore/BlockHeader.h>
+#include <libethereum/ChainParams.h>
+#include <libethereum/LogFilter.h>
+#include <libethereum/Transaction.h>
+#include <libethereum/TransactionQueue.h>
+#include <libethereum/TransactionReceipt.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// Signed transactions from @a _senders accounts with @a _perSender consecutive nonces each.
+vector<bytes> signedTransactions(unsigned _senders, unsigned _perSender)
+{
+    vector<bytes> ret;
+    for (unsigned s = 0; s < _senders; ++s)
+    {
+        Secret const secret{sha3(h256(s + 1))};
+        for (unsigned n = 0; n < _perSender; ++n)
+            ret.push_back(Transaction(1, u256(1000000000) + s, 21000, Address(s + 1), bytes(), n, secret)
+                              .rlp());
+    }
+    return ret;
+}
+
+void transactionSenderRecovery(benchmark::State& _state)
+{
+    bytes const tx = signedTransactions(1, 1).front();
+    for (auto _: _state)
+    {
+        Transaction const t(tx, CheckTransaction::None);
+        benchmark::DoNotOptimize(t.sender());
+    }
+    _state.SetItemsProcessed(_state.iterations());
+}
+BENCHMARK(transactionSenderRecovery);
+
+void blockHeaderDecode(benchmark::State& _state)
+{
+    bytes const block = ChainParams(genesisInfo(Network::MainNetwork)).genesisBlock();
+    for (auto _: _state)
+    {
+        BlockHeader const header(block);
+        benchmark::DoNotOptimize(header.hash());
+    }
+    _state.SetItemsProcessed(_state.iterations());
+}
+BENCHMARK(blockHeaderDecode);
+
+void transactionQueueImport(benchmark::State& _state)
+{
+    vector<bytes> const txs = signedTransactions(_state.range(0), 10);
+    for (auto _: _state)
+    {
+        _state.PauseTiming();
+        TransactionQueue tq(txs.size(), txs.size());
+        _state.ResumeTiming();
+
+        for (auto const& tx: txs)
+            tq.import(tx);
+    }
+    _state.SetItemsProcessed(_state.iterations() * txs.size());
+}
+BENCHMARK(transactionQueueImport)->Arg(1)->Arg(100);
+
+void transactionQueueTopTransactions(benchmark::State& _state)
+{
+    vector<bytes> const txs = signedTransactions(100, 10);
+    TransactionQueue tq(txs.size(), txs.size());
+    for (auto const& tx: txs)
+        tq.import(tx);
+
+    for (auto _: _state)
+        benchmark::DoNotOptimize(tq.topTransactions(_state.range(0)));
+    _state.SetItemsProcessed(_state.iterations() * _state.range(0));
+}
+BENCHMARK(transactionQueueTopTransactions)->Arg(10)->Arg(1000);
+
+void logFilterMatching(benchmark::State& _state)
+{
+    Address const contract{sha3(bytes{1})};
+    h256 const event = sha3(string("Transfer(address,address,uint256)"));
+    LogFilter const filter = LogFilter().address(contract).topic(0, event);
+
+    TransactionReceipts receipts;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        LogEntries logs;
+        for (unsigned l = 0; l < 4; ++l)
+            logs.emplace_back(
+                l == 0 && i % 10 == 0 ? contract : Address(i * 4 + l), h256s{event}, bytes(32));
+        receipts.emplace_back(h256(), 21000, logs);
+    }
+
+    for (auto _: _state)
+        for (auto const& r: receipts)
+            if (filter.matches(r.bloom()))
+                benchmark::DoNotOptimize(filter.matches(r));
+    _state.SetItemsProcessed(_state.iterations() * receipts.size());
+}
+BENCHMARK(logFilterMatching);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -26,6 +26,7 @@
 #include <boost/iostreams/device/null.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/program_options.hpp>
+#include <thread>
 
 using namespace std;
 using namespace dev::test;
@@ -55,6 +56,7 @@ void printHelp()
     cout << setw(30) << "--jsontrace <Options>" << setw(25) << "Enable VM trace to stdout in json format. Argument is a json config: '{ \"disableStorage\" : false, \"disableMemory\" : false, \"disableStack\" : false, \"fullStorage\" : true }'\n";
     cout << setw(30) << "--stats <OutFile>" << setw(25) << "Output debug stats to the file\n";
     cout << setw(30) << "--exectimelog" << setw(25) << "Output execution time for each test suite\n";
+    cout << setw(30) << "--jobs <n>" << setw(25) << "Run the test files of a suite in n worker processes (0 - one per core)\n";
     cout << setw(30) << "--statediff" << setw(25) << "Trace state difference for state tests\n";
 
     cout << "\nAdditional Tests\n";
@@ -206,6 +208,13 @@ Options::Options(int argc, const char** argv)
         }
         else if (arg == "--exectimelog")
             exectimelog = true;
+        else if (arg == "--jobs")
+        {
+            throwIfNoArgumentFollows();
+            jobs = atoi(argv[++i]);
+            if (!jobs)
+                jobs = max(std::thread::hardware_concurrency(), 1u);
+        }
         else if (arg == "--all")
             all = true;
         else if (arg == "--singletest")
@@ -41,6 +41,7 @@ public:
     bool stats = false;		///< Execution time and stats for state tests
     std::string statsOutFile; ///< Stats output file. "out" for standard output
     bool exectimelog = false; ///< Print execution time for each test suite
+    unsigned jobs = 1;      ///< Number of worker processes sharing the test files of a folder
     std::string rCurrentTestSuite; ///< Remember test suite before boost overwrite (for random tests)
     bool statediff = false;///< Fill full post state in General tests
     bool fulloutput = false;///< Replace large output to just it's length
@@ -17,6 +17,7 @@
 
 #include <test/tools/libtesteth/Stats.h>
 #include <test/tools/libtesteth/Options.h>
+#include <algorithm>
 #include <iterator>
 #include <numeric>
 #include <fstream>
@@ -48,6 +49,23 @@ void Stats::testFinished(int64_t _gasUsed)
 	m_stats.push_back({clock::now() - m_tp, _gasUsed, m_currentSuite + "/" + m_currentTest});
 }
 
+void Stats::save(boost::filesystem::path const& _file, size_t _from) const
+{
+	std::ofstream file{_file.string()};
+	for (auto s = m_stats.begin() + std::min(_from, m_stats.size()); s != m_stats.end(); ++s)
+		file << s->duration.count() << "\t" << s->gasUsed << "\t" << s->name << "\n";
+}
+
+void Stats::merge(boost::filesystem::path const& _file)
+{
+	std::ifstream file{_file.string()};
+	clock::rep duration;
+	int64_t gasUsed;
+	std::string name;
+	while (file >> duration >> gasUsed && std::getline(file >> std::ws, name))
+		m_stats.push_back({clock::duration{duration}, gasUsed, name});
+}
+
 std::ostream& operator<<(std::ostream& out, Stats::clock::duration const& d)
 {
 	return out << std::setw(10) << std::right << std::chrono::duration_cast<std::chrono::microseconds>(d).count() << " us";
@@ -47,6 +47,14 @@ public:
 	void testStarted(std::string const& _name) override;
 	void testFinished(int64_t _gasUsed) override;
 
+	/// @returns the number of items collected so far.
+	size_t size() const { return m_stats.size(); }
+	/// Write the items collected from the @a _from th on to @a _file, to be merged by another
+	/// process.
+	void save(boost::filesystem::path const& _file, size_t _from = 0) const;
+	/// Append the items written to @a _file by save().
+	void merge(boost::filesystem::path const& _file);
+
 private:
 	clock::time_point m_tp;
 	std::string m_currentSuite;
@@ -22,8 +22,14 @@
 #include <test/tools/libtesteth/Stats.h>
 #include <test/tools/libtesteth/TestHelper.h>
 #include <test/tools/libtesteth/TestSuite.h>
+#include <libdevcore/TransientDirectory.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/test/results_collector.hpp>
 #include <string>
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 using namespace std;
 using namespace dev;
 namespace fs = boost::filesystem;
@@ -174,13 +180,90 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
 
 	auto& testOutput = test::TestOutputHelper::get();
 	testOutput.initTest(files.size());
-	for (auto const& file: files)
+	if (Options::get().jobs > 1 && files.size() > 1)
+		executeTestsInWorkers(_testFolder, files);
+	else
+		for (auto const& file: files)
+		{
+			testOutput.showProgress();
+			testOutput.setCurrentTestFile(file);
+			executeTest(_testFolder, file);
+		}
+	testOutput.finishTest();
+}
+
+void TestSuite::executeTestsInWorkers(string const& _testFolder, vector<fs::path> const& _files) const
+{
+#if defined(_WIN32)
+	for (auto const& file: _files)
 	{
-		testOutput.showProgress();
-		testOutput.setCurrentTestFile(file);
+		TestOutputHelper::get().setCurrentTestFile(file);
 		executeTest(_testFolder, file);
 	}
-	testOutput.finishTest();
+#else
+	namespace utf = boost::unit_test;
+
+	unsigned const jobs = min<size_t>(Options::get().jobs, _files.size());
+	// Every worker gets its own temporary directory, so that the databases it creates in
+	// TransientDirectory don't clash with the ones of its siblings.
+	TransientDirectory workersDir;
+	vector<pid_t> workers;
+	// The workers inherit the items collected so far, and only report the ones they add.
+	size_t const statsBefore = Stats::get().size();
+	Timer timer;
+	cout.flush();
+	cerr.flush();
+	for (unsigned w = 0; w < jobs; ++w)
+	{
+		fs::path const workerDir = fs::path(workersDir.path()) / toString(w);
+		fs::create_directories(workerDir);
+		pid_t const pid = fork();
+		BOOST_REQUIRE_MESSAGE(pid >= 0, "Failed to fork a test worker");
+		if (pid > 0)
+		{
+			workers.push_back(pid);
+			continue;
+		}
+
+		// Worker process: run every jobs-th file and report through the exit status.
+		setenv("TMPDIR", workerDir.c_str(), 1);
+		bool passed = true;
+		try
+		{
+			for (size_t i = w; i < _files.size(); i += jobs)
+			{
+				TestOutputHelper::get().setCurrentTestFile(_files[i]);
+				executeTest(_testFolder, _files[i]);
+			}
+			utf::test_unit_id const id = utf::framework::current_test_case().p_id;
+			passed = utf::results_collector.results(id).passed();
+		}
+		catch (...)
+		{
+			passed = false;
+		}
+		if (Options::get().stats)
+			Stats::get().save(workerDir / "stats", statsBefore);
+		cout.flush();
+		cerr.flush();
+		_exit(passed ? 0 : 1);
+	}
+
+	for (unsigned w = 0; w < workers.size(); ++w)
+	{
+		int status = 0;
+		waitpid(workers[w], &status, 0);
+		BOOST_CHECK_MESSAGE(WIFEXITED(status) && WEXITSTATUS(status) == 0,
+			"Test worker " + toString(w) + " of " + _testFolder + " failed");
+		fs::path const stats = fs::path(workersDir.path()) / toString(w) / "stats";
+		if (Options::get().stats && fs::exists(stats))
+			Stats::get().merge(stats);
+	}
+
+	if (Options::get().exectimelog)
+		cout << _testFolder << ": " << _files.size() << " files in " << jobs << " workers, "
+			 << timer.elapsed() << "s\n";
+#endif
 }
 
 fs::path TestSuite::getFullPathFiller(string const& _testFolder) const
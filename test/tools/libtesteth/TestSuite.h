@@ -33,6 +33,9 @@ private:
 	// Execute Test.json file
 	void executeFile(boost::filesystem::path const& _file) const;
 
+	// Execute the filler files of _testFolder in Options::jobs forked worker processes
+	void executeTestsInWorkers(std::string const& _testFolder, std::vector<boost::filesystem::path> const& _files) const;
+
 protected:
 	// A folder of the test suite. like "VMTests". should be implemented for each test suite.
 	virtual boost::filesystem::path suiteFolder() const = 0;
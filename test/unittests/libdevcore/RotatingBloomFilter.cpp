@@ -0,0 +1,65 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Rotating Bloom filter unit tests.
+
+#include <libdevcore/RotatingBloomFilter.h>
+#include <test/tools/libtesteth/TestOutputHelper.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::test;
+
+BOOST_FIXTURE_TEST_SUITE(RotatingBloomFilterSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(remembersLastInsertedHashes)
+{
+    size_t const capacity = 1000;
+    RotatingBloomFilter filter{capacity, 0.001};
+
+    h256s inserted;
+    for (size_t i = 0; i < 3 * capacity; ++i)
+    {
+        inserted.push_back(h256::random());
+        filter.insert(inserted.back());
+    }
+
+    for (size_t i = inserted.size() - capacity; i < inserted.size(); ++i)
+        BOOST_CHECK(filter.contains(inserted[i]));
+
+    // The oldest generation has been dropped.
+    size_t remembered = 0;
+    for (size_t i = 0; i < capacity; ++i)
+        remembered += filter.contains(inserted[i]);
+    BOOST_CHECK_LT(remembered, capacity / 50);
+}
+
+BOOST_AUTO_TEST_CASE(falsePositiveRateIsBounded)
+{
+    size_t const capacity = 10000;
+    RotatingBloomFilter filter{capacity, 0.001};
+    for (size_t i = 0; i < 2 * capacity; ++i)
+        filter.insert(h256::random());
+
+    size_t falsePositives = 0;
+    for (size_t i = 0; i < capacity; ++i)
+        falsePositives += filter.contains(h256::random());
+    // Two full filters: about 0.2% expected.
+    BOOST_CHECK_LT(falsePositives, capacity / 100);
+}
+
+BOOST_AUTO_TEST_CASE(clearForgetsEverything)
+{
+    RotatingBloomFilter filter{16, 0.001};
+    h256 const hash = h256::random();
+    filter.insert(hash);
+    BOOST_CHECK(filter.contains(hash));
+    filter.clear();
+    BOOST_CHECK(!filter.contains(hash));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
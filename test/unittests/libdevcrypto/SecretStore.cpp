@@ -216,6 +216,45 @@ BOOST_AUTO_TEST_CASE(recode)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(batch_import_and_recode)
+{
+	TransientDirectory storeDir;
+	string password = "foobar";
+	string changedPassword = "abcdefg";
+	vector<bytesSec> secrets;
+	for (unsigned i = 0; i < 3; ++i)
+		secrets.push_back(bytesSec(h256::random().asBytes()));
+
+	vector<h128> uuids;
+	{
+		SecretStore store(storeDir.path());
+		uuids = store.importSecrets(secrets, password, KDF::PBKDF2_SHA256, 2);
+		BOOST_REQUIRE_EQUAL(uuids.size(), 3);
+		BOOST_CHECK_EQUAL(store.keys().size(), 3);
+	}
+	{
+		SecretStore store(storeDir.path());
+		BOOST_CHECK_EQUAL(store.keys().size(), 3);
+		vector<bytesSec> const wrong = store.secrets(uuids, changedPassword, 2);
+		for (auto const& s: wrong)
+			BOOST_CHECK(s.empty());
+		vector<bytesSec> const read = store.secrets(uuids, password, 2);
+		for (unsigned i = 0; i < 3; ++i)
+			BOOST_CHECK_EQUAL(toHex(read[i].makeInsecure()), toHex(secrets[i].makeInsecure()));
+
+		vector<h128> toRecode = uuids;
+		toRecode.push_back(h128::random());
+		vector<bool> const recoded = store.recode(toRecode, changedPassword, password, KDF::PBKDF2_SHA256, 2);
+		BOOST_CHECK(recoded == vector<bool>({true, true, true, false}));
+	}
+	{
+		SecretStore store(storeDir.path());
+		vector<bytesSec> const read = store.secrets(uuids, changedPassword, 2);
+		for (unsigned i = 0; i < 3; ++i)
+			BOOST_CHECK_EQUAL(toHex(read[i].makeInsecure()), toHex(secrets[i].makeInsecure()));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(keyImport_PBKDF2SHA256)
 {
 	// Imports a key from an external file. Tests that the imported key is there
@@ -540,6 +540,81 @@ BOOST_AUTO_TEST_CASE(hashedLowerBound)
     BOOST_CHECK(itHashToKey == hashToKey.end());
 }
 
+BOOST_AUTO_TEST_CASE(trieProof)
+{
+    StateCacheDB memdb;
+    GenericTrieDB<StateCacheDB> trie(&memdb);
+    trie.init();
+
+    std::map<bytes, bytes> values;
+    for (int i = 0; i < 200; ++i)
+    {
+        // Short keys give nodes embedded in their parent and values held by branches.
+        bytes const key = i % 2 ? asBytes(toString(i)) : sha3(toString(i)).asBytes();
+        bytes const value = asBytes(toString(i));
+        trie.insert(key, value);
+        values[key] = value;
+    }
+    bytes const missing = sha3(std::string("missing")).asBytes();
+
+    TrieNodeCache cache;
+    size_t nodes = 0;
+    for (auto const& kv : values)
+    {
+        std::string value;
+        auto const proof = trie.proof(kv.first, &cache, &value);
+        BOOST_REQUIRE(!proof.empty());
+        BOOST_CHECK(sha3(proof.front()) == trie.root());
+        BOOST_CHECK(value == asString(kv.second));
+        nodes += proof.size();
+
+        // The proof alone is enough to look the key up.
+        StateCacheDB proofdb;
+        for (auto const& n : proof)
+            proofdb.insert(sha3(n), &n);
+        GenericTrieDB<StateCacheDB> const proved(&proofdb, trie.root());
+        BOOST_CHECK(proved.at(kv.first) == asString(kv.second));
+    }
+    // The nodes near the root were looked up once for all the keys.
+    BOOST_CHECK_LT(cache.size(), nodes);
+
+    std::string value = "not empty";
+    auto const proof = trie.proof(missing, &cache, &value);
+    BOOST_CHECK(value.empty());
+    StateCacheDB proofdb;
+    for (auto const& n : proof)
+        proofdb.insert(sha3(n), &n);
+    GenericTrieDB<StateCacheDB> const proved(&proofdb, trie.root());
+    BOOST_CHECK(proved.at(missing).empty());
+}
+
+BOOST_AUTO_TEST_CASE(trieProofMissingNode)
+{
+    StateCacheDB memdb;
+    GenericTrieDB<StateCacheDB> trie(&memdb);
+    trie.init();
+    for (int i = 0; i < 200; ++i)
+        trie.insert(sha3(toString(i)).asBytes(), asBytes(toString(i)));
+    bytes const key = sha3(toString(0)).asBytes();
+
+    // Only the root of the trie is in the database.
+    auto const proof = trie.proof(key);
+    BOOST_REQUIRE_GT(proof.size(), 1);
+    StateCacheDB rootdb;
+    rootdb.insert(trie.root(), &proof.front());
+    GenericTrieDB<StateCacheDB> const partial(&rootdb, trie.root());
+    BOOST_CHECK_THROW(partial.proof(key), InvalidTrie);
+
+    // The empty trie needs no node in the database.
+    StateCacheDB emptydb;
+    GenericTrieDB<StateCacheDB> const empty(&emptydb, EmptyTrie, Verification::Skip);
+    std::string value = "not empty";
+    auto const emptyProof = empty.proof(key, nullptr, &value);
+    BOOST_REQUIRE_EQUAL(emptyProof.size(), 1);
+    BOOST_CHECK(sha3(emptyProof.front()) == EmptyTrie);
+    BOOST_CHECK(value.empty());
+}
+
 BOOST_AUTO_TEST_CASE(trieStess)
 {
     cnote << "Stress-testing Trie...";
@@ -71,6 +71,164 @@ BOOST_AUTO_TEST_CASE(opendb)
     setDatabaseKind(preDatabaseKind);
 }
 
+BOOST_AUTO_TEST_CASE(reindex)
+{
+    auto const preDatabaseKind = databaseKind();
+    setDatabaseKind(DatabaseKind::LevelDB);
+
+    TestBlockChain testBc(TestBlockChain::defaultGenesisBlock());
+    TransientDirectory tempDirBlockchain;
+    ChainParams p(genesisInfo(TestBlockChain::s_sealEngineNetwork), testBc.testGenesis().bytes(),
+        testBc.testGenesis().accountMap());
+    BlockChain bc(p, tempDirBlockchain.path(), WithExisting::Kill);
+
+    h256s transactionHashes;
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        TestTransaction tr = TestTransaction::defaultTransaction(i);
+        TestBlock block;
+        block.addTransaction(tr);
+        block.mine(testBc);
+        testBc.addBlock(block);
+        bc.insert(block.bytes(), block.receipts());
+        transactionHashes.push_back(tr.transaction().sha3());
+    }
+    h256 const head = bc.currentHash();
+    u256 const totalDifficulty = bc.details().totalDifficulty;
+
+    bc.reopen(WithExisting::Reindex);
+
+    BOOST_CHECK_EQUAL(bc.number(), 3);
+    BOOST_CHECK_EQUAL(bc.currentHash(), head);
+    BOOST_CHECK_EQUAL(bc.details().totalDifficulty, totalDifficulty);
+    BOOST_CHECK_EQUAL(bc.details(bc.numberHash(2)).children.size(), 1);
+    for (unsigned i = 0; i < transactionHashes.size(); ++i)
+        BOOST_CHECK_EQUAL(bc.transactionLocation(transactionHashes[i]).first, bc.numberHash(i + 1));
+    BOOST_CHECK_EQUAL(bc.receipts(head).receipts.size(), 1);
+    BOOST_CHECK(bc.blockBloom(3) != LogBloom());
+
+    setDatabaseKind(preDatabaseKind);
+}
+
+BOOST_AUTO_TEST_CASE(reindexStopsBeforeBadBlock)
+{
+    auto const preDatabaseKind = databaseKind();
+    setDatabaseKind(DatabaseKind::LevelDB);
+
+    TestBlockChain testBc(TestBlockChain::defaultGenesisBlock());
+    TransientDirectory tempDirBlockchain;
+    ChainParams p(genesisInfo(TestBlockChain::s_sealEngineNetwork), testBc.testGenesis().bytes(),
+        testBc.testGenesis().accountMap());
+    unique_ptr<BlockChain> bc(new BlockChain(p, tempDirBlockchain.path(), WithExisting::Kill));
+
+    h256s transactionHashes;
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        TestTransaction tr = TestTransaction::defaultTransaction(i);
+        TestBlock block;
+        block.addTransaction(tr);
+        block.mine(testBc);
+        testBc.addBlock(block);
+        bc->insert(block.bytes(), block.receipts());
+        transactionHashes.push_back(tr.transaction().sha3());
+    }
+    h256 const good = bc->numberHash(1);
+    h256 const bad = bc->numberHash(2);
+    h256 const above = bc->numberHash(3);
+    boost::filesystem::path const extrasPath =
+        boost::filesystem::path(tempDirBlockchain.path()) /
+        toHex(bc->genesisHash().ref().cropped(0, 4)) / toString(c_databaseVersion) / "extras";
+    bc.reset();
+
+    // Lose the receipts of block #2, so that reindexing finds it bad.
+    db::DBFactory::create(extrasPath)->kill(toSlice(bad, ExtraReceipts));
+
+    bc.reset(new BlockChain(p, tempDirBlockchain.path(), WithExisting::Reindex));
+
+    BOOST_CHECK_EQUAL(bc->number(), 1);
+    BOOST_CHECK_EQUAL(bc->currentHash(), good);
+    BOOST_CHECK(bc->details(good).children.empty());
+    for (h256 const& h: {bad, above})
+    {
+        BOOST_CHECK(!bc->isKnown(h));
+        BOOST_CHECK(!bc->details(h));
+        BOOST_CHECK(bc->receipts(h).receipts.empty());
+    }
+    BOOST_CHECK_EQUAL(bc->numberHash(2), h256());
+    BOOST_CHECK_EQUAL(bc->numberHash(3), h256());
+    BOOST_CHECK_EQUAL(bc->transactionLocation(transactionHashes[0]).first, good);
+    BOOST_CHECK_EQUAL(bc->transactionLocation(transactionHashes[1]).first, h256());
+    BOOST_CHECK_EQUAL(bc->transactionLocation(transactionHashes[2]).first, h256());
+    BOOST_CHECK(bc->blockBloom(2) == LogBloom());
+
+    setDatabaseKind(preDatabaseKind);
+}
+
+BOOST_AUTO_TEST_CASE(receiptsData)
+{
+    TestBlockChain bc(TestBlockChain::defaultGenesisBlock());
+    TestBlock block;
+    block.addTransaction(TestTransaction::defaultTransaction());
+    block.mine(bc);
+    bc.addBlock(block);
+
+    BlockChain const& chain = bc.getInterface();
+    h256 const head = chain.currentHash();
+    BOOST_REQUIRE_EQUAL(chain.receipts(head).receipts.size(), 1);
+    BOOST_CHECK(chain.receiptsData(head) == chain.receipts(head).rlp());
+    BOOST_CHECK(chain.receiptsData(chain.genesisHash()) == rlpList());
+    BOOST_CHECK(chain.receiptsData(h256::random()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(importPerformanceStages)
+{
+    TestBlockChain bc(TestBlockChain::defaultGenesisBlock());
+    unordered_map<string, double> stages;
+    bc.interfaceUnsafe().setOnImportPerformance(
+        [&](BlockHeader const&, unordered_map<string, double> const& _stages) { stages = _stages; });
+
+    TestTransaction tr = TestTransaction::defaultTransaction();
+    TestBlock block;
+    block.addTransaction(tr);
+    block.mine(bc);
+    bc.addBlock(block);
+
+    for (auto const& stage: {"preliminaryChecks", "enactment", "stateCommit", "writing", "route",
+             "dbWrite", "checkBest", "total"})
+        BOOST_CHECK_MESSAGE(stages.count(stage), stage);
+}
+
+BOOST_AUTO_TEST_CASE(lastBlockHashesFollowChain)
+{
+    TestBlockChain bc(TestBlockChain::defaultGenesisBlock());
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        TestBlock block;
+        block.mine(bc);
+        bc.addBlock(block);
+    }
+    BlockChain const& chain = bc.getInterface();
+    LastBlockHashesFace const& lastHashes = chain.lastBlockHashes();
+
+    h256s const hashes = lastHashes.precedingHashes(chain.numberHash(3));
+    BOOST_REQUIRE_EQUAL(hashes.size(), 256);
+    for (unsigned i = 0; i <= 3; ++i)
+        BOOST_CHECK_EQUAL(hashes[i], chain.numberHash(3 - i));
+    BOOST_CHECK_EQUAL(hashes[4], h256());
+
+    h256s const older = lastHashes.precedingHashes(chain.numberHash(1));
+    BOOST_CHECK_EQUAL(older[0], chain.numberHash(1));
+    BOOST_CHECK_EQUAL(older[1], chain.numberHash(0));
+    BOOST_CHECK_EQUAL(older[2], h256());
+
+    BOOST_CHECK(lastHashes.precedingHashes(chain.numberHash(3)) == hashes);
+
+    h256 const unknown{1};
+    h256s const none = lastHashes.precedingHashes(unknown);
+    BOOST_CHECK_EQUAL(none[0], unknown);
+    BOOST_CHECK_EQUAL(none[1], h256());
+}
+
 BOOST_AUTO_TEST_CASE(Mining_1_mineBlockWithTransaction)
 {
     TestBlockChain bc(TestBlockChain::defaultGenesisBlock());
@@ -0,0 +1,47 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// CallPool unit tests.
+
+#include <libethereum/CallPool.h>
+#include <test/tools/libtesteth/TestHelper.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+BOOST_FIXTURE_TEST_SUITE(CallPoolSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(runReturnsResultsFromWorkers)
+{
+    CallPool pool(CallPool::Limits{2, 4, 1000, chrono::seconds(10)});
+    BOOST_CHECK_EQUAL(pool.run([]() { return 42; }), 42);
+    BOOST_CHECK_THROW(pool.run([]() -> int { BOOST_THROW_EXCEPTION(CallPoolBusy()); }), CallPoolBusy);
+    BOOST_CHECK_EQUAL(pool.status().completed, 2);
+}
+
+BOOST_AUTO_TEST_CASE(callsOverTheQueueLimitAreRejected)
+{
+    CallPool pool(CallPool::Limits{1, 1, 1000, chrono::milliseconds(50)});
+    promise<void> release;
+    shared_future<void> released = release.get_future().share();
+
+    // Occupies the only worker past its timeout, then fills the queue.
+    BOOST_CHECK_THROW(pool.run([released]() { released.wait(); return 0; }), CallTimedOut);
+    thread queued([&]() { BOOST_CHECK_THROW(pool.run([]() { return 0; }), CallTimedOut); });
+    while (pool.status().queued == 0)
+        this_thread::yield();
+
+    BOOST_CHECK_THROW(pool.run([]() { return 0; }), CallPoolBusy);
+    queued.join();
+    release.set_value();
+
+    CallPool::Status const status = pool.status();
+    BOOST_CHECK_EQUAL(status.rejected, 1);
+    BOOST_CHECK_EQUAL(status.timedOut, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// EthereumHostData unit tests.
+
+#include <libethereum/BlockChain.h>
+#include <libethereum/EthereumHostData.h>
+#include <test/tools/libtesteth/BlockChainHelper.h>
+#include <test/tools/libtesteth/TestHelper.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+namespace
+{
+/// Chain of three blocks with a transaction each.
+class ServedChainFixture : public FrontierNoProofTestFixture
+{
+public:
+    ServedChainFixture()
+    {
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            TestBlock block;
+            block.addTransaction(TestTransaction::defaultTransaction(i));
+            block.mine(testBc);
+            testBc.addBlock(block);
+            hashes.push_back(chain().currentHash());
+        }
+        request = rlp(hashes);
+    }
+
+    BlockChain const& chain() const { return testBc.getInterface(); }
+
+    bytes body(h256 const& _hash) const
+    {
+        bytes const block = chain().block(_hash);
+        RLP const r(block);
+        RLPStream s(2);
+        s.appendRaw(r[1].data()).appendRaw(r[2].data());
+        return s.out();
+    }
+
+    TestBlockChain testBc{TestBlockChain::defaultGenesisBlock()};
+    h256s hashes;
+    bytes request;
+    OverlayDB db;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EthereumHostDataSuite, ServedChainFixture)
+
+BOOST_AUTO_TEST_CASE(servedItemsCacheEvictsLeastRecentlyUsed)
+{
+    ServedItemsCache cache(10);
+    h256 const a(1), b(2), c(3);
+    cache.insert(a, bytes(4, 1));
+    cache.insert(b, bytes(4, 2));
+    BOOST_REQUIRE(cache.find(a));
+
+    // Over the bound, the least recently used item goes.
+    cache.insert(c, bytes(4, 3));
+    BOOST_CHECK(cache.find(a));
+    BOOST_CHECK(!cache.find(b));
+    BOOST_CHECK(cache.find(c));
+
+    // An item over the bound is kept, alone.
+    bytes const& big = cache.insert(b, bytes(20, 2));
+    BOOST_CHECK(big == bytes(20, 2));
+    BOOST_CHECK(!cache.find(a));
+    BOOST_CHECK(!cache.find(c));
+    BOOST_REQUIRE(cache.find(b));
+    BOOST_CHECK(*cache.find(b) == bytes(20, 2));
+}
+
+BOOST_AUTO_TEST_CASE(blockBodiesWithinBudget)
+{
+    bytes const body0 = body(hashes[0]);
+    bytes const body1 = body(hashes[1]);
+    EthereumHostData hostData(chain(), db, body0.size() + body1.size());
+
+    // Served from the chain, then from the served bodies cache.
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        auto const reply = hostData.blockBodies(RLP(request));
+        BOOST_CHECK_EQUAL(reply.second, 2);
+        BOOST_CHECK(reply.first == body0 + body1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(receiptsWithinBudget)
+{
+    bytes const receipts0 = chain().receiptsData(hashes[0]);
+    bytes const receipts1 = chain().receiptsData(hashes[1]);
+    bytes const receipts2 = chain().receiptsData(hashes[2]);
+    EthereumHostData hostData(chain(), db, receipts0.size() + receipts1.size() + receipts2.size());
+
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        auto const reply = hostData.receipts(RLP(request));
+        BOOST_CHECK_EQUAL(reply.second, 3);
+        BOOST_CHECK(reply.first == receipts0 + receipts1 + receipts2);
+    }
+
+    // Unknown blocks are skipped.
+    bytes const partlyUnknown = rlp(h256s{h256::random(), hashes[1]});
+    auto const reply = hostData.receipts(RLP(partlyUnknown));
+    BOOST_CHECK_EQUAL(reply.second, 1);
+    BOOST_CHECK(reply.first == receipts1);
+}
+
+BOOST_AUTO_TEST_CASE(firstItemServedOverBudget)
+{
+    EthereumHostData hostData(chain(), db, 1);
+
+    auto const bodies = hostData.blockBodies(RLP(request));
+    BOOST_CHECK_EQUAL(bodies.second, 1);
+    BOOST_CHECK(bodies.first == body(hashes[0]));
+
+    auto const receipts = hostData.receipts(RLP(request));
+    BOOST_CHECK_EQUAL(receipts.second, 1);
+    BOOST_CHECK(receipts.first == chain().receiptsData(hashes[0]));
+}
+
+BOOST_AUTO_TEST_CASE(nodeDataWithinBudget)
+{
+    h256s nodeHashes;
+    for (byte i = 0; i < 3; ++i)
+    {
+        bytes const node(100, i);
+        nodeHashes.push_back(sha3(node));
+        db.insert(nodeHashes.back(), &node);
+    }
+
+    bytes const nodeRequest = rlp(nodeHashes);
+
+    EthereumHostData hostData(chain(), db, 250);
+    BOOST_CHECK_EQUAL(hostData.nodeData(RLP(nodeRequest)).size(), 2);
+
+    EthereumHostData tightHostData(chain(), db, 50);
+    strings const data = tightHostData.nodeData(RLP(nodeRequest));
+    BOOST_REQUIRE_EQUAL(data.size(), 1);
+    BOOST_CHECK(data.front() == string(100, 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
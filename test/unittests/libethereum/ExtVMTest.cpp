@@ -21,6 +21,7 @@
 
 #include <libethereum/Block.h>
 #include <libethereum/ExtVM.h>
+#include <libevm/EVMCHostExtensions.h>
 
 using namespace dev;
 using namespace dev::eth;
@@ -111,5 +112,43 @@ BOOST_AUTO_TEST_CASE(BlockhashDoesntNeedLastHashesInExperimental)
     BOOST_REQUIRE_EQUAL(hash, blockchain.numberHash(200));
 }
 
+BOOST_AUTO_TEST_CASE(HostExtensionsReadStorageAndAccountsInOneCallback)
+{
+    Block block = blockchain.genesisBlock(genesisDB);
+    block.sync(blockchain);
+
+    Address addr("0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b");
+    bytes const code{0x60, 0x00};
+    block.mutableState().setStorage(addr, 1, 10);
+    block.mutableState().setStorage(addr, 2, 20);
+    block.mutableState().setCode(addr, bytes{code});
+
+    TestLastBlockHashes lastBlockHashes({});
+    EnvInfo envInfo(block.info(), lastBlockHashes, 0);
+    ExtVM extVM(block.mutableState(), envInfo, *blockchain.sealEngine(), addr, addr, addr, 0, 0, {},
+        {}, {}, 0, false, false);
+
+    evmc_context& context = extVM;
+    auto const& host = reinterpret_cast<aleth_host_interface const&>(*context.host);
+    evmc_address const address = toEvmC(addr);
+
+    evmc_bytes32 const keys[] = {toEvmC(u256(1)), toEvmC(u256(2)), toEvmC(u256(3))};
+    evmc_bytes32 values[3];
+    host.get_storage_batch(&context, &address, keys, values, 3);
+    BOOST_CHECK_EQUAL(fromEvmC(values[0]), 10);
+    BOOST_CHECK_EQUAL(fromEvmC(values[1]), 20);
+    BOOST_CHECK_EQUAL(fromEvmC(values[2]), 0);
+
+    aleth_account_info info;
+    host.get_account_info(&context, &address, &info);
+    BOOST_CHECK(info.exists);
+    BOOST_CHECK_EQUAL(fromEvmC(info.balance), block.state().balance(addr));
+    BOOST_CHECK_EQUAL(info.code_size, code.size());
+    BOOST_CHECK_EQUAL(fromEvmC(info.code_hash), u256(sha3(code)));
+
+    size_t codeSize = 0;
+    uint8_t const* codeData = host.get_code(&context, &address, &codeSize);
+    BOOST_CHECK(bytesConstRef(codeData, codeSize) == bytesConstRef(&code));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
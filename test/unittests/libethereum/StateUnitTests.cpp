@@ -53,6 +53,151 @@ BOOST_AUTO_TEST_CASE(LoadAccountCode)
     ));
 }
 
+BOOST_AUTO_TEST_CASE(StateDiffRevertAndReapply)
+{
+    Address const sender{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    Address const contract{"bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"};
+    State s{0};
+    s.addBalance(sender, 1000);
+    s.createContract(contract);
+    s.setStorage(contract, 1, 10);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+    h256 const rootBefore = s.rootHash();
+
+    s.startStateDiff();
+    s.subBalance(sender, 100);
+    s.addBalance(contract, 100);
+    s.setStorage(contract, 1, 11);
+    s.setStorage(contract, 2, 20);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+    Address const created{"cccccccccccccccccccccccccccccccccccccccc"};
+    s.addBalance(created, 1);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+    h256 const rootAfter = s.rootHash();
+
+    bytes const diffRLP = s.takeStateDiff().rlp();
+    StateDiff const diff{RLP(diffRLP)};
+    BOOST_CHECK_EQUAL(diff.rootBefore, rootBefore);
+    BOOST_CHECK_EQUAL(diff.rootAfter, rootAfter);
+    BOOST_REQUIRE_EQUAL(diff.accounts.size(), 3);
+    BOOST_CHECK_EQUAL(diff.accounts.at(sender).before.balance, 1000);
+    BOOST_CHECK_EQUAL(diff.accounts.at(sender).after.balance, 900);
+    BOOST_CHECK(!diff.accounts.at(created).before.exists);
+    BOOST_CHECK(diff.accounts.at(contract).storage.at(1) == make_pair(u256(10), u256(11)));
+    BOOST_CHECK(diff.accounts.at(contract).storage.at(2) == make_pair(u256(0), u256(20)));
+
+    s.applyStateDiff(diff, StateDiffDirection::Revert);
+    BOOST_CHECK_EQUAL(s.rootHash(), rootBefore);
+    BOOST_CHECK_EQUAL(s.balance(sender), 1000);
+    BOOST_CHECK_EQUAL(s.storage(contract, 1), 10);
+    BOOST_CHECK(!s.addressInUse(created));
+
+    s.applyStateDiff(diff, StateDiffDirection::Forward);
+    BOOST_CHECK_EQUAL(s.rootHash(), rootAfter);
+    BOOST_CHECK_EQUAL(s.storage(contract, 2), 20);
+
+    BOOST_CHECK_THROW(s.applyStateDiff(diff, StateDiffDirection::Forward), InvalidStateDiffRoot);
+}
+
+BOOST_AUTO_TEST_CASE(ChangeLogKeepsFirstChangeSinceSavepoint)
+{
+    Address const addr{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    State s{0};
+    s.addBalance(addr, 100);
+    s.setStorage(addr, 1, 10);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+
+    size_t const outer = s.savepoint();
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        s.setStorage(addr, 1, 11 + i);
+        s.addBalance(addr, 1);
+        s.incNonce(addr);
+    }
+    BOOST_CHECK_EQUAL(s.changeLog().size(), 3);
+
+    size_t const inner = s.savepoint();
+    s.setStorage(addr, 1, 50);
+    s.addBalance(addr, 5);
+    s.setStorage(addr, 1, 51);
+    BOOST_CHECK_EQUAL(s.changeLog().size(), 5);
+
+    s.rollback(inner);
+    BOOST_CHECK_EQUAL(s.storage(addr, 1), 20);
+    BOOST_CHECK_EQUAL(s.balance(addr), 110);
+    BOOST_CHECK_EQUAL(s.getNonce(addr), 10);
+
+    s.setStorage(addr, 1, 60);
+    s.rollback(outer);
+    BOOST_CHECK_EQUAL(s.storage(addr, 1), 10);
+    BOOST_CHECK_EQUAL(s.balance(addr), 100);
+    BOOST_CHECK_EQUAL(s.getNonce(addr), 0);
+    BOOST_CHECK(s.changeLog().empty());
+}
+
+BOOST_AUTO_TEST_CASE(CommitKeepsAccountsCached)
+{
+    Address const addr{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    State s{0};
+    s.addBalance(addr, 100);
+    s.setStorage(addr, 1, 10);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+
+    s.setStorage(addr, 1, 11);
+    s.setStorage(addr, 2, 20);
+    s.addBalance(addr, 1);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+    BOOST_CHECK_EQUAL(s.originalStorageValue(addr, 1), 11);
+    BOOST_CHECK_EQUAL(s.storage(addr, 2), 20);
+
+    s.setStorage(addr, 1, 12);
+    BOOST_CHECK_EQUAL(s.originalStorageValue(addr, 1), 11);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+
+    State reloaded{s};
+    reloaded.setRoot(s.rootHash());
+    BOOST_CHECK_EQUAL(reloaded.storage(addr, 1), 12);
+    BOOST_CHECK_EQUAL(reloaded.storage(addr, 2), 20);
+    BOOST_CHECK_EQUAL(reloaded.balance(addr), 101);
+
+    s.kill(addr);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+    BOOST_CHECK(!s.addressInUse(addr));
+}
+
+BOOST_AUTO_TEST_CASE(ChangeLogIndexGrowsAndSurvivesRollback)
+{
+    Address const addr{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    State s{0};
+    s.addBalance(addr, 1);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+
+    // More slots than the initial size of the index.
+    size_t const outer = s.savepoint();
+    for (unsigned i = 0; i < 1000; ++i)
+        s.setStorage(addr, i, i + 1);
+    size_t const inner = s.savepoint();
+    for (unsigned round = 0; round < 2; ++round)
+        for (unsigned i = 0; i < 1000; ++i)
+            s.setStorage(addr, i, i + 2 + round);
+    BOOST_CHECK_EQUAL(s.changeLog().size(), 2000);
+
+    // Positions freed by the rollback are reused by other slots.
+    s.rollback(inner);
+    for (unsigned i = 1000; i < 2000; ++i)
+        s.setStorage(addr, i, 1);
+    for (unsigned i = 0; i < 1000; ++i)
+        s.setStorage(addr, i, 0);
+    BOOST_CHECK_EQUAL(s.changeLog().size(), 3000);
+
+    s.rollback(inner);
+    for (unsigned i = 0; i < 2000; ++i)
+        BOOST_CHECK_EQUAL(s.storage(addr, i), i < 1000 ? i + 1 : 0);
+    s.rollback(outer);
+    BOOST_CHECK_EQUAL(s.storage(addr, 999), 0);
+    BOOST_CHECK(s.changeLog().empty());
+}
+
 class AddressRangeTestFixture : public TestOutputHelperFixture
 {
 public:
@@ -0,0 +1,93 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Transaction fetcher unit tests.
+
+#include <libethereum/TransactionFetcher.h>
+#include <test/tools/libtesteth/TestOutputHelper.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+BOOST_FIXTURE_TEST_SUITE(TransactionFetcherSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(fetcherAsksOnePeerPerTransaction)
+{
+    TransactionFetcher fetcher;
+    NodeID const a = NodeID::random();
+    NodeID const b = NodeID::random();
+    h256 const tx = h256::random();
+
+    fetcher.noteAnnounced(a, {tx});
+    fetcher.noteAnnounced(b, {tx});
+    auto requests = fetcher.takeRequests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 1);
+    BOOST_CHECK_EQUAL(requests.begin()->second.size(), 1);
+
+    // Nothing more to ask while the request is in flight.
+    BOOST_CHECK(fetcher.takeRequests().empty());
+
+    NodeID const asked = requests.begin()->first;
+    BOOST_CHECK(fetcher.noteDelivered(asked, {tx}));
+    BOOST_CHECK_EQUAL(fetcher.size(), 0);
+    BOOST_CHECK(fetcher.takeRequests().empty());
+
+    // Not fetched again when announced later.
+    fetcher.noteAnnounced(asked == a ? b : a, {tx});
+    BOOST_CHECK_EQUAL(fetcher.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(fetcherRetriesWithAnotherPeer)
+{
+    TransactionFetcher fetcher;
+    NodeID const a = NodeID::random();
+    NodeID const b = NodeID::random();
+    h256 const missing = h256::random();
+    h256 const late = h256::random();
+
+    fetcher.noteAnnounced(a, {missing, late});
+    fetcher.noteAnnounced(b, {missing, late});
+    auto const now = TransactionFetcher::Clock::now();
+    auto requests = fetcher.takeRequests(now);
+    BOOST_REQUIRE_EQUAL(requests.size(), 1);
+    NodeID const first = requests.begin()->first;
+    NodeID const second = first == a ? b : a;
+
+    // An empty reply: the transactions are asked from the other peer.
+    BOOST_CHECK(fetcher.noteDelivered(first, {}));
+    requests = fetcher.takeRequests(now);
+    BOOST_REQUIRE_EQUAL(requests.size(), 1);
+    BOOST_CHECK_EQUAL(requests.begin()->first, second);
+    BOOST_CHECK_EQUAL(requests.begin()->second.size(), 2);
+
+    // Nobody else to ask once the second request times out.
+    BOOST_CHECK(fetcher.takeRequests(now + chrono::seconds(10)).empty());
+    BOOST_CHECK_EQUAL(fetcher.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(fetcherForgetsDisconnectedPeers)
+{
+    TransactionFetcher fetcher;
+    NodeID const a = NodeID::random();
+    NodeID const b = NodeID::random();
+    h256 const tx = h256::random();
+
+    fetcher.noteAnnounced(a, {tx});
+    BOOST_REQUIRE_EQUAL(fetcher.takeRequests().count(a), 1);
+    fetcher.noteAnnounced(b, {tx});
+    fetcher.notePeerGone(a);
+
+    auto const requests = fetcher.takeRequests();
+    BOOST_REQUIRE_EQUAL(requests.size(), 1);
+    BOOST_CHECK_EQUAL(requests.begin()->first, b);
+
+    BOOST_CHECK(!fetcher.noteDelivered(a, {h256::random()}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Transaction performance records unit tests.
+
+#include <libethereum/ChainParams.h>
+#include <libethereum/State.h>
+#include <libethereum/TransactionPerformance.h>
+#include <test/tools/libtesteth/TestHelper.h>
+#include <test/tools/libtestutils/TestLastBlockHashes.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+BOOST_FIXTURE_TEST_SUITE(TransactionPerformanceSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(logKeepsTheLatestRecords)
+{
+    TransactionPerformanceLog log;
+    TransactionPerformance record;
+    log.record(TransactionPerformance(record));
+    BOOST_CHECK(!log.enabled());
+    BOOST_CHECK(log.records().empty());
+
+    log.enable(3);
+    for (unsigned i = 0; i < 5; ++i)
+    {
+        record.index = i;
+        log.record(TransactionPerformance(record));
+    }
+
+    vector<TransactionPerformance> const records = log.records();
+    BOOST_REQUIRE_EQUAL(records.size(), 3);
+    BOOST_CHECK_EQUAL(records.front().index, 2);
+    BOOST_CHECK_EQUAL(records.back().index, 4);
+    BOOST_REQUIRE_EQUAL(log.records(1).size(), 1);
+    BOOST_CHECK_EQUAL(log.records(1).front().index, 4);
+
+    log.enable(0);
+    BOOST_CHECK(!log.enabled());
+    BOOST_CHECK(log.records().empty());
+}
+
+BOOST_AUTO_TEST_CASE(stateCountsReadsWritesAndMisses)
+{
+    Address const addr{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    State s{0};
+    s.addBalance(addr, 100);
+    s.setStorage(addr, 1, 10);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+
+    State reloaded{s};
+    reloaded.setRoot(s.rootHash());
+    reloaded.resetExecutionCounters();
+    BOOST_CHECK_EQUAL(reloaded.storage(addr, 1), 10);
+    BOOST_CHECK_EQUAL(reloaded.storage(addr, 1), 10);
+    BOOST_CHECK_EQUAL(reloaded.balance(addr), 100);
+    // Writes look the account and the previous value up without counting them as reads.
+    reloaded.setStorage(addr, 2, 20);
+    reloaded.addBalance(addr, 5);
+    reloaded.notePrecompileCall(Address(1));
+
+    ExecutionCounters const& counters = reloaded.executionCounters();
+    BOOST_CHECK_EQUAL(counters.stateReads, 3);
+    BOOST_CHECK_EQUAL(counters.stateWrites, 2);
+    // The account and the two slots, each loaded once.
+    BOOST_CHECK_EQUAL(counters.dbMisses, 3);
+    BOOST_CHECK_EQUAL(counters.precompiles.at(Address(1)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(transferCountsReadsAndWrites)
+{
+    KeyPair const sender = KeyPair::create();
+    Address const to{"bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"};
+    State s{0};
+    s.addBalance(sender.address(), 1 * ether);
+    s.commit(State::CommitBehaviour::KeepEmptyAccounts);
+    s.resetExecutionCounters();
+
+    BlockHeader header;
+    header.setGasLimit(1000000);
+    TestLastBlockHashes lastBlockHashes(h256s(256, h256()));
+    EnvInfo const envInfo{header, lastBlockHashes, 0};
+    unique_ptr<SealEngineFace> se{
+        ChainParams(genesisInfo(Network::ConstantinopleTest)).createSealEngine()};
+    Transaction const t{1000, 1, 21000, to, bytes(), 0, sender.secret()};
+    s.execute(envInfo, *se, t, Permanence::Uncommitted);
+
+    ExecutionCounters const& counters = s.executionCounters();
+    // The sender's nonce and balance, and whether the recipient has code.
+    BOOST_CHECK_EQUAL(counters.stateReads, 3);
+    // Gas payment, nonce, value debit and credit, refund and fees.
+    BOOST_CHECK_EQUAL(counters.stateWrites, 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
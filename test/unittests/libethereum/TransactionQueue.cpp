@@ -154,7 +154,8 @@ BOOST_AUTO_TEST_CASE(tqFuture)
     txq.setFuture(tx2.sha3());
     BOOST_CHECK((Transactions { tx0, tx1 }) == txq.topTransactions(256));
 
-    Transaction tx2_2(1, gasCostMed, gas, dest, bytes(), 2, sender );
+    // Replacing a future transaction also needs a 10% higher gas price.
+    Transaction tx2_2(1, gasCostMed * 11 / 10, gas, dest, bytes(), 2, sender );
     txq.import(tx2_2);
     BOOST_CHECK((Transactions { tx0, tx1, tx2_2, tx3, tx4 }) == txq.topTransactions(256));
 }
@@ -184,6 +185,56 @@ BOOST_AUTO_TEST_CASE(tqLimits)
     BOOST_CHECK((Transactions { tx5, tx0, tx1 }) == txq.topTransactions(256));
 }
 
+BOOST_AUTO_TEST_CASE(tqReplacementNeedsPriceBump)
+{
+    TransactionQueue txq;
+    Address const dest("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+    Secret const sender("0x3333333333333333333333333333333333333333333333333333333333333333");
+    Transaction const tx(0, 100, 25000, dest, bytes(), 0, sender);
+    Transaction const tx109(0, 109, 25000, dest, bytes(), 0, sender);
+    Transaction const tx110(0, 110, 25000, dest, bytes(), 0, sender);
+
+    BOOST_CHECK(txq.import(tx) == ImportResult::Success);
+    BOOST_CHECK(txq.import(tx109) == ImportResult::OverbidGasPrice);
+    BOOST_CHECK(txq.import(tx110) == ImportResult::Success);
+    BOOST_CHECK((Transactions{tx110}) == txq.topTransactions(256));
+}
+
+BOOST_AUTO_TEST_CASE(tqSenderLimit)
+{
+    TransactionQueue txq(TransactionQueue::Limits{1024, 1024, 1024 * 1024, 2});
+    Address const dest("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+    Secret const sender("0x3333333333333333333333333333333333333333333333333333333333333333");
+    Secret const sender2("0x4444444444444444444444444444444444444444444444444444444444444444");
+
+    BOOST_CHECK(txq.import(Transaction(0, 100, 25000, dest, bytes(), 0, sender)) == ImportResult::Success);
+    BOOST_CHECK(txq.import(Transaction(0, 100, 25000, dest, bytes(), 1, sender)) == ImportResult::Success);
+    BOOST_CHECK(txq.import(Transaction(0, 100, 25000, dest, bytes(), 2, sender)) == ImportResult::TooManyFromSender);
+    // Replacements are still accepted.
+    BOOST_CHECK(txq.import(Transaction(0, 200, 25000, dest, bytes(), 1, sender)) == ImportResult::Success);
+    BOOST_CHECK(txq.import(Transaction(0, 100, 25000, dest, bytes(), 0, sender2)) == ImportResult::Success);
+    BOOST_CHECK_EQUAL(txq.status().current, 3);
+}
+
+BOOST_AUTO_TEST_CASE(tqByteLimit)
+{
+    Address const dest("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+    Secret const sender("0x3333333333333333333333333333333333333333333333333333333333333333");
+    Secret const sender2("0x4444444444444444444444444444444444444444444444444444444444444444");
+    Transaction const cheapLarge(0, 100, 1000000, dest, bytes(10000), 0, sender);
+    Transaction const small(0, 200, 25000, dest, bytes(), 0, sender2);
+
+    TransactionQueue txq(TransactionQueue::Limits{1024, 1024, 10000});
+    BOOST_CHECK(txq.import(small) == ImportResult::Success);
+    BOOST_CHECK(txq.import(cheapLarge) == ImportResult::QueueFull);
+    BOOST_CHECK((Transactions{small}) == txq.topTransactions(256));
+    BOOST_CHECK_EQUAL(txq.status().bytes, small.rlp().size());
+
+    // Evicted transactions are forgotten and can be imported again.
+    BOOST_CHECK(!txq.isKnown(cheapLarge.sha3()));
+    BOOST_CHECK(txq.import(cheapLarge) == ImportResult::QueueFull);
+}
+
 BOOST_AUTO_TEST_CASE(tqImport)
 {
     TestTransaction testTransaction = TestTransaction::defaultTransaction();
@@ -247,7 +298,7 @@ BOOST_AUTO_TEST_CASE(tqLimit)
         TestTransaction testTransaction = TestTransaction::defaultTransaction(i);
         ImportResult res = tq.import(testTransaction.transaction());
         from = testTransaction.transaction().from();
-        BOOST_REQUIRE(res == ImportResult::Success);
+        BOOST_REQUIRE(res == (i < 6 ? ImportResult::Success : ImportResult::QueueFull));
     }
 
     //5 is imported and 6th is dropped
@@ -304,4 +355,41 @@ BOOST_AUTO_TEST_CASE(tqEqueue)
     BOOST_REQUIRE(topTr.size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(tqEnqueueReportsEveryTransactionOutsideTheLock)
+{
+    TransactionQueue tq;
+    Secret const sec("0x45a915e4d060149eb4365960e6a7a45f334393093061116b197e3240065ff2d8");
+    Address const dest("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+
+    RLPStream rlpStream(5);
+    for (unsigned nonce = 0; nonce < 4; ++nonce)
+        rlpStream.appendRaw(Transaction(0, 10 * szabo, 25000, dest, bytes(), nonce, sec).rlp());
+    rlpStream.appendRaw(Transaction(0, 10 * szabo, 25000, dest, bytes(), 0, sec).rlp());
+
+    Mutex x_results;
+    map<ImportResult, unsigned> results;
+    size_t knownWhenReported = 0;
+    auto importHandler = tq.onImport([&](ImportResult _ir, h256 const&, h512 const&) {
+        // Would deadlock if the queue was still locked.
+        size_t const known = tq.knownTransactions().size();
+        Guard l(x_results);
+        ++results[_ir];
+        knownWhenReported = max(knownWhenReported, known);
+    });
+
+    tq.enqueue(RLP(rlpStream.out()), h512());
+    auto reported = [&]() {
+        Guard l(x_results);
+        return results[ImportResult::Success] + results[ImportResult::AlreadyKnown];
+    };
+    for (unsigned i = 0; i < 100 && reported() < 5; ++i)
+        this_thread::sleep_for(chrono::milliseconds(50));
+
+    Guard l(x_results);
+    BOOST_CHECK_EQUAL(results[ImportResult::Success], 4);
+    BOOST_CHECK_EQUAL(results[ImportResult::AlreadyKnown], 1);
+    BOOST_CHECK_EQUAL(knownWhenReported, 4);
+    BOOST_CHECK_EQUAL(tq.topTransactions(10).size(), 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -488,6 +488,41 @@ public:
     AlethInterpreterSstoreTestFixture() : SstoreTestFixture{new EVMC{evmc_create_interpreter()}} {}
 };
 
+class FusedInstructionsTestFixture : public TestOutputHelperFixture
+{
+public:
+    FusedInstructionsTestFixture() { state.addBalance(address, 1 * ether); }
+
+    /// Runs @a _code on @a _vm, @returns its output and the gas used.
+    std::pair<bytes, u256> run(VMFace& _vm, bytes const& _code, OnOpFunc const& _onOp = {})
+    {
+        state.setCode(address, bytes{_code});
+        return runInFrame(_vm, _code, _onOp);
+    }
+
+    /// Runs @a _code in the frame of the account at `address` without installing it there, as
+    /// DELEGATECALL and CALLCODE run the code of another account.
+    std::pair<bytes, u256> runInFrame(
+        VMFace& _vm, bytes const& _code, OnOpFunc const& _onOp = {})
+    {
+        ExtVM extVm(state, envInfo, *se, address, address, address, 0, 1, {}, ref(_code),
+            sha3(_code), 0, false, false);
+        u256 gas = 1000000;
+        owning_bytes_ref ret = _vm.exec(gas, extVm, _onOp);
+        return {ret.toBytes(), 1000000 - gas};
+    }
+
+    BlockHeader blockHeader{initBlockHeader()};
+    LastBlockHashes lastBlockHashes;
+    EnvInfo envInfo{blockHeader, lastBlockHashes, 0};
+    Address address{KeyPair::create().address()};
+    State state{0};
+    std::unique_ptr<SealEngineFace> se{
+        ChainParams(genesisInfo(Network::ConstantinopleTest)).createSealEngine()};
+    LegacyVM legacyVM;
+    EVMC interpreter{evmc_create_interpreter()};
+};
+
 }  // namespace
 
 BOOST_FIXTURE_TEST_SUITE(LegacyVMSuite, TestOutputHelperFixture)
@@ -666,6 +701,26 @@ BOOST_AUTO_TEST_CASE(LegacyVMSstoreEip1283Case17)
     testEip1283Case17();
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(LegacyVMTracingSuite, FusedInstructionsTestFixture)
+
+BOOST_AUTO_TEST_CASE(LegacyVMTracedAndUntracedRunsMatch)
+{
+    bytes const code =
+        fromHex("600560005b819060030101906001900390816100045760005260206000f3");
+
+    uint64_t steps = 0;
+    auto const traced = run(legacyVM, code,
+        [&](uint64_t, uint64_t, Instruction, bigint, bigint, bigint, VMFace const*,
+            ExtVMFace const*) { ++steps; });
+    BOOST_CHECK(steps > 0);
+
+    auto const untraced = run(legacyVM, code);
+    BOOST_CHECK(untraced.first == traced.first);
+    BOOST_CHECK_EQUAL(untraced.second, traced.second);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -837,4 +892,53 @@ BOOST_AUTO_TEST_CASE(AlethInterpreterSstoreEip1283Case17)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_SUITE(AlethInterpreterFusedInstructionsSuite, FusedInstructionsTestFixture)
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterFusedInstructionsMatchLegacyVM)
+{
+    // Loop of DUP2 SWAP1, PUSH1 ADD and PUSH2 JUMPI summing 3 + i for i from 5 down to 1,
+    // storing the result with PUSH1 MSTORE.
+    bytes const code =
+        fromHex("600560005b819060030101906001900390816100045760005260206000f3");
+
+    auto const expected = run(legacyVM, code);
+    BOOST_CHECK(expected.first == h256(u256(30)).asBytes());
+
+    // Second run reuses the cached analysis of the code.
+    for (int i = 0; i < 2; ++i)
+    {
+        auto const result = run(interpreter, code);
+        BOOST_CHECK(result.first == expected.first);
+        BOOST_CHECK_EQUAL(result.second, expected.second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterFusedPushOverflowsFullStack)
+{
+    bytes code;
+    for (unsigned i = 0; i < 1024; ++i)
+        code += fromHex("6000");
+    code += fromHex("600101");
+
+    BOOST_CHECK_THROW(run(legacyVM, code), OutOfStack);
+    BOOST_CHECK_THROW(run(interpreter, code), OutOfStack);
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterDelegatedCodeOfEqualSizeIsNotTakenFromCache)
+{
+    // Both return a word from memory and have the same size.
+    bytes const ownCode = fromHex("602a60005260206000f3");
+    bytes const libraryCode = fromHex("600760005260206000f3");
+    BOOST_REQUIRE_EQUAL(ownCode.size(), libraryCode.size());
+
+    BOOST_CHECK(run(interpreter, ownCode).first == h256(u256(42)).asBytes());
+
+    // A DELEGATECALL or CALLCODE into the library runs its code with the caller's address as the
+    // destination of the message.
+    BOOST_CHECK(runInFrame(interpreter, libraryCode).first == h256(u256(7)).asBytes());
+    BOOST_CHECK(run(interpreter, ownCode).first == h256(u256(42)).asBytes());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
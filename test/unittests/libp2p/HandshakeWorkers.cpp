@@ -0,0 +1,67 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Handshake workers and connection admission unit tests.
+
+#include <libp2p/HandshakeWorkers.h>
+#include <test/tools/libtesteth/TestOutputHelper.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <condition_variable>
+#include <mutex>
+
+using namespace std;
+using namespace dev;
+using namespace dev::p2p;
+using namespace dev::test;
+
+BOOST_FIXTURE_TEST_SUITE(HandshakeWorkersSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(rateLimiterRefillsPerAddress)
+{
+    ConnectionRateLimiter limiter{2, 60};
+    auto const a = bi::address::from_string("10.0.0.1");
+    auto const b = bi::address::from_string("10.0.0.2");
+    auto const now = chrono::steady_clock::now();
+
+    BOOST_CHECK(limiter.admit(a, now));
+    BOOST_CHECK(limiter.admit(a, now));
+    BOOST_CHECK(!limiter.admit(a, now));
+    BOOST_CHECK(limiter.admit(b, now));
+
+    // One connection per second comes back.
+    BOOST_CHECK(limiter.admit(a, now + chrono::seconds(1)));
+    BOOST_CHECK(!limiter.admit(a, now + chrono::seconds(1)));
+}
+
+BOOST_AUTO_TEST_CASE(workersRejectJobsOverTheLimit)
+{
+    HandshakeWorkers workers{1, 2};
+    mutex m;
+    condition_variable cv;
+    bool release = false;
+    unsigned done = 0;
+    auto const job = [&]() {
+        unique_lock<mutex> l(m);
+        cv.wait(l, [&]() { return release; });
+        ++done;
+        cv.notify_all();
+    };
+
+    BOOST_REQUIRE(workers.post(job));
+    BOOST_REQUIRE(workers.post(job));
+    BOOST_CHECK(!workers.post(job));
+    BOOST_CHECK_EQUAL(workers.queued(), 2);
+
+    {
+        unique_lock<mutex> l(m);
+        release = true;
+        cv.notify_all();
+        cv.wait(l, [&]() { return done == 2; });
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Node database unit tests.
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/TransientDirectory.h>
+#include <libp2p/NodeDB.h>
+#include <test/tools/libtesteth/TestOutputHelper.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::p2p;
+using namespace dev::test;
+
+namespace
+{
+NodeIPEndpoint endpoint(uint16_t _port)
+{
+    return NodeIPEndpoint(bi::address::from_string("10.0.0.1"), _port, _port);
+}
+
+chrono::hours const c_week{24 * 7};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(NodeDBSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(nodeDBSurvivesReopening)
+{
+    TransientDirectory dir;
+    boost::filesystem::path const path = boost::filesystem::path(dir.path()) / "nodes.rlp";
+    NodeID const a = NodeID::random();
+    NodeID const b = NodeID::random();
+    CapDescs const caps{{"eth", 63}};
+    {
+        NodeDB db{path};
+        db.noteSession(a, endpoint(30303), caps);
+        db.noteSession(b, endpoint(30304), caps);
+        db.noteSession(a, endpoint(30305), caps);
+        db.notePong(a, chrono::milliseconds(40));
+    }
+
+    NodeDB db{path};
+    BOOST_REQUIRE_EQUAL(db.size(), 2);
+    NodeRecord const record = db.node(a);
+    BOOST_CHECK_EQUAL(record.id, a);
+    BOOST_CHECK_EQUAL(record.endpoint.tcpPort(), 30305);
+    BOOST_CHECK(record.latency == chrono::milliseconds(40));
+    BOOST_REQUIRE_EQUAL(record.capabilities.size(), 1);
+    BOOST_CHECK_EQUAL(record.capabilities.front().second, 63);
+    BOOST_CHECK(!db.node(NodeID::random()).id);
+}
+
+BOOST_AUTO_TEST_CASE(nodeDBIgnoresTruncatedRecord)
+{
+    TransientDirectory dir;
+    boost::filesystem::path const path = boost::filesystem::path(dir.path()) / "nodes.rlp";
+    NodeID const a = NodeID::random();
+    {
+        NodeDB db{path};
+        db.noteSession(a, endpoint(30303), {});
+        db.noteSession(NodeID::random(), endpoint(30304), {});
+    }
+    bytes data = contents(path);
+    data.resize(data.size() - 10);
+    writeFile(path, data);
+
+    {
+        NodeDB db{path};
+        BOOST_CHECK_EQUAL(db.size(), 1);
+        BOOST_CHECK_EQUAL(db.node(a).id, a);
+    }
+    // The truncated record was dropped when the file was compacted.
+    BOOST_CHECK_EQUAL(NodeDB{path}.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(nodeDBBestNodesByLatency)
+{
+    TransientDirectory dir;
+    NodeDB db{boost::filesystem::path(dir.path()) / "nodes.rlp"};
+    NodeID const slow = NodeID::random();
+    NodeID const fast = NodeID::random();
+    NodeID const silent = NodeID::random();
+    NodeID const local = NodeID::random();
+    db.noteSession(silent, endpoint(30303), {});
+    db.noteSession(slow, endpoint(30304), {});
+    db.noteSession(fast, endpoint(30305), {});
+    db.noteSession(local, endpoint(30306), {});
+    db.notePong(slow, chrono::milliseconds(200));
+    db.notePong(fast, chrono::milliseconds(20));
+    // Peers on the local network answer within a millisecond.
+    db.notePong(local, chrono::microseconds(300));
+    db.notePong(NodeID::random(), chrono::milliseconds(1));
+
+    vector<NodeRecord> const best = db.bestNodes(10, c_week);
+    BOOST_REQUIRE_EQUAL(best.size(), 4);
+    BOOST_CHECK_EQUAL(best[0].id, local);
+    BOOST_CHECK_EQUAL(best[1].id, fast);
+    BOOST_CHECK_EQUAL(best[2].id, slow);
+    BOOST_CHECK_EQUAL(best[3].id, silent);
+    BOOST_CHECK_EQUAL(db.bestNodes(1, c_week).size(), 1);
+    BOOST_CHECK(db.bestNodes(10, chrono::seconds(-1)).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -161,6 +161,7 @@ struct TestNodeTable: public NodeTable
     using NodeTable::m_buckets;
     using NodeTable::m_evictions;
     using NodeTable::m_socket;
+    using NodeTable::nearestNodeEntries;
     using NodeTable::noteActiveNode;
 };
 
@@ -311,6 +312,47 @@ BOOST_AUTO_TEST_CASE(test_findnode_neighbours)
     // into the same list of nearest nodes.
 }
 
+BOOST_AUTO_TEST_CASE(xorDistance)
+{
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        NodeID const a = NodeID::random();
+        NodeID const b = NodeID::random();
+        u256 d = sha3(a) ^ sha3(b);
+        int expected = 0;
+        while (d >>= 1)
+            ++expected;
+        BOOST_CHECK_EQUAL(NodeTable::distance(a, b), expected);
+    }
+    BOOST_CHECK_EQUAL(NodeTable::distance(h256(), h256()), 0);
+    BOOST_CHECK_EQUAL(NodeTable::distance(h256(), h256(1)), 0);
+    BOOST_CHECK_EQUAL(NodeTable::distance(h256(), h256(2)), 1);
+    BOOST_CHECK_EQUAL(NodeTable::distance(h256(), ~h256()), 255);
+}
+
+BOOST_AUTO_TEST_CASE(nearestNodeEntriesAreTheClosest)
+{
+    TestNodeTableHost node(256);
+    node.populate();
+    auto const all = node.nodeTable->snapshot();
+
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        NodeID const target = NodeID::random();
+        h256 const targetHash = sha3(target);
+        vector<h256> expected;
+        for (auto const& n : all)
+            expected.push_back(n.hash ^ targetHash);
+        sort(expected.begin(), expected.end());
+        expected.resize(min<size_t>(expected.size(), 16));
+
+        vector<h256> actual;
+        for (auto const& n : node.nodeTable->nearestNodeEntries(target))
+            actual.push_back(n->hash ^ targetHash);
+        BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(kademlia)
 {
     TestNodeTableHost node(8);
@@ -15,8 +15,12 @@
     along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <libdevcore/TransientDirectory.h>
+#include <libethcore/Exceptions.h>
+#include <libethcore/KeyManager.h>
 #include <libweb3jsonrpc/AccountHolder.h>
 
+#include <boost/filesystem.hpp>
 #include <gtest/gtest.h>
 
 using namespace std;
@@ -61,3 +65,40 @@ TEST(AccountHolder, proxyAccountUseCase)
     EXPECT_TRUE(!h.removeProxyAccount(secondID));
     EXPECT_TRUE(h.removeProxyAccount(id));
 }
+
+TEST(AccountHolder, simpleAccountHolderKeepsDecryptedKeys)
+{
+    TransientDirectory tempDir;
+    boost::filesystem::create_directories(tempDir.path() + "/keys");
+    KeyManager keyManager(tempDir.path() + "/keys.info", tempDir.path() + "/keys");
+    KeyPair const key = KeyPair::create();
+    keyManager.import(key.secret(), "account", "password", string());
+
+    SimpleAccountHolder h(
+        function<Interface*()>(),
+        [](Address) -> string {
+            ADD_FAILURE() << "Password input requested";
+            return string();
+        },
+        keyManager, [](TransactionSkeleton const&, bool) { return false; });
+
+    EXPECT_FALSE(h.secret(key.address(), "wrong"));
+    EXPECT_EQ(key.secret(), h.secret(key.address(), "password"));
+    // Served from the cache, and the wrong password still doesn't match it.
+    EXPECT_EQ(key.secret(), h.secret(key.address(), "password"));
+    EXPECT_FALSE(h.secret(key.address(), "wrong"));
+    EXPECT_FALSE(h.secret(Address("abababababababababababababababababababab"), "password"));
+
+    TransactionSkeleton t;
+    t.from = key.address();
+    EXPECT_THROW(h.authenticate(t), TransactionRefused);
+
+    ASSERT_TRUE(h.unlockAccount(key.address(), "password", 60));
+    auto const authenticated = h.authenticate(t);
+    EXPECT_FALSE(authenticated.first);
+    EXPECT_EQ(key.secret(), authenticated.second);
+
+    // Unlocking for zero seconds locks the account again.
+    EXPECT_TRUE(h.unlockAccount(key.address(), "password", 0));
+    EXPECT_THROW(h.authenticate(t), TransactionRefused);
+}